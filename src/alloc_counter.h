@@ -0,0 +1,12 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstdint>
+
+// Contador de alocações do processo. alloc_counter.cpp substitui o
+// operator new/delete global (new, new[], alinhado) e conta toda chamada a
+// new; só entra nos executáveis que precisam medir (snake_bench e
+// alloc_test), nunca na SnakeSim.
+std::uint64_t HeapAllocations();
+
+#endif  // ALLOC_COUNTER_H
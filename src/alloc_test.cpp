@@ -0,0 +1,77 @@
+// alloc_test: confere que o regime permanente do jogo não aloca no heap.
+// Conta toda chamada a operator new do processo e, depois de aquecer uma
+// rodada na RoundArena, exige zero durante:
+//   steady_step   Bot + Simulation::Step por várias partidas seguidas,
+//                 recomeçadas com Simulation::Reset
+//   reset/L       Simulation::Reset com ObstacleLayout L (regenerate, keep)
+// Registrado no ctest; sai com 1 se algum caso alocar.
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include "alloc_counter.h"
+#include "bot.h"
+#include "round_arena.h"
+#include "simulation.h"
+
+namespace {
+
+constexpr int kSide = 32;
+constexpr int kObstacles = 64;
+constexpr float kSpeed = 0.16f;
+constexpr int kWarmupGames = 3;
+constexpr std::uint64_t kSteadyTicks = 200000;
+constexpr int kResets = 2000;
+
+// Roda fn e retorna quantas alocações aconteceram dentro dela
+std::uint64_t CountAllocations(const std::function<void()>& fn) {
+    std::uint64_t before = HeapAllocations();
+    fn();
+    return HeapAllocations() - before;
+}
+
+bool Check(const std::string& name, std::uint64_t allocations) {
+    if (allocations != 0) {
+        std::cout << "FAIL " << name << ": " << allocations << " heap allocations\n";
+        return false;
+    }
+    std::cout << "ok   " << name << "\n";
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    RoundArena arena;
+    Simulation sim(kSide, kSide, kSpeed, kObstacles, 1, arena.Resource());
+    Bot bot(Bot::kDefaultExpansionBudget, arena.Resource());
+    std::uint32_t seed = 2;
+    // Partidas seguidas no mesmo Simulation, alternando o layout
+    auto play = [&](std::uint64_t ticks) {
+        for (std::uint64_t i = 0; i < ticks; ++i) {
+            if (sim.IsOver()) {
+                ObstacleLayout layout = seed % 2 == 0 ? ObstacleLayout::Regenerate : ObstacleLayout::Keep;
+                sim.Reset(seed++, layout);
+                bot.Reset();
+            }
+            sim.Step(bot.NextInput(sim));
+        }
+    };
+
+    // Aquecimento: o bot dimensiona seus buffers e as partidas chegam ao
+    // tamanho de regime
+    for (int game = 0; game < kWarmupGames; ++game) {
+        while (!sim.IsOver()) sim.Step(bot.NextInput(sim));
+        play(1);
+    }
+
+    bool ok = true;
+    ok &= Check("steady_step", CountAllocations([&] { play(kSteadyTicks); }));
+    ok &= Check("reset/regenerate", CountAllocations([&] {
+        for (int i = 0; i < kResets; ++i) sim.Reset(seed++, ObstacleLayout::Regenerate);
+    }));
+    ok &= Check("reset/keep", CountAllocations([&] {
+        for (int i = 0; i < kResets; ++i) sim.Reset(seed++, ObstacleLayout::Keep);
+    }));
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+#include "arena.h"
+#include <algorithm>
+
+namespace {
+
+constexpr std::uint8_t kOpposite[4] = {1, 0, 3, 2};  // ordem de Snake::Direction
+
+}  // namespace
+
+Arena::Arena(int grid_width, int grid_height, int num_snakes, int num_food, int num_obstacles,
+             float speed, std::uint32_t seed, std::pmr::memory_resource *resource)
+    : width_(grid_width),
+      height_(grid_height),
+      grid_(grid_width, grid_height, resource),
+      rng_(seed),
+      head_x_(resource),
+      head_y_(resource),
+      speed_(resource),
+      direction_(resource),
+      alive_(resource),
+      growing_(resource),
+      head_cell_(resource),
+      next_cell_(resource),
+      score_(resource),
+      death_(resource),
+      bodies_(resource),
+      movers_(resource),
+      claim_stamp_(resource),
+      claim_by_(resource),
+      head_stamp_(resource),
+      head_by_(resource),
+      food_target_(num_food) {
+  std::size_t cells = static_cast<std::size_t>(grid_width) * grid_height;
+  claim_stamp_.assign(cells, 0);
+  claim_by_.assign(cells, -1);
+  head_stamp_.assign(cells, 0);
+  head_by_.assign(cells, -1);
+
+  // Reserva por cobra de uma vez: do recurso monotônico, crescer desperdiça
+  const std::size_t max_snakes = static_cast<std::size_t>(std::max(num_snakes, 0));
+  for (auto *fixed : {&head_x_, &head_y_, &speed_}) fixed->reserve(max_snakes);
+  for (auto *flags : {&direction_, &alive_, &growing_}) flags->reserve(max_snakes);
+  for (auto *ints : {&head_cell_, &next_cell_, &score_, &movers_}) ints->reserve(max_snakes);
+  death_.reserve(max_snakes);
+  bodies_.reserve(max_snakes);
+
+  int cell;
+  for (int i = 0; i < num_obstacles && RandomFreeCell(cell); ++i) {
+    grid_.Set(cell % width_, cell / width_, OccupancyGrid::kObstacle);
+  }
+  // Cabeça no centro da célula; todas com a mesma velocidade, em Q16
+  Snake::Fixed clamped_speed = std::min(std::max(Snake::ToFixed(speed), Snake::Fixed{0}), Snake::kOne);
+  for (int i = 0; i < num_snakes && RandomFreeCell(cell); ++i) {
+    grid_.Set(cell % width_, cell / width_, OccupancyGrid::kSnake);
+    head_x_.push_back((static_cast<Snake::Fixed>(cell % width_) << Snake::kFracBits) + Snake::kOne / 2);
+    head_y_.push_back((static_cast<Snake::Fixed>(cell / width_) << Snake::kFracBits) + Snake::kOne / 2);
+    speed_.push_back(clamped_speed);
+    direction_.push_back(static_cast<std::uint8_t>(rng_.UniformInt(4)));
+    alive_.push_back(1);
+    growing_.push_back(0);
+    head_cell_.push_back(cell);
+    next_cell_.push_back(-1);
+    score_.push_back(0);
+    death_.push_back(ArenaDeath::None);
+    // RingBuffer não recebe o recurso do vetor: vai explícito
+    bodies_.emplace_back(resource);
+    bodies_.back().reserve(16);
+    bodies_.back().push_back(cell);
+  }
+  alive_count_ = NumSnakes();
+  RefillFood();
+}
+
+bool Arena::RandomFreeCell(int &cell) {
+  if (grid_.FreeCount() == 0) return false;
+  int x, y;
+  grid_.FreeCell(static_cast<int>(rng_.UniformInt(static_cast<std::uint32_t>(grid_.FreeCount()))), x, y);
+  cell = y * width_ + x;
+  return true;
+}
+
+void Arena::RefillFood() {
+  int cell;
+  while (food_count_ < food_target_ && RandomFreeCell(cell)) {
+    grid_.Set(cell % width_, cell / width_, OccupancyGrid::kFood);
+    ++food_count_;
+  }
+}
+
+void Arena::Step(const std::vector<SimInput> &inputs, ThreadPool *pool) {
+  const int n = NumSnakes();
+  if (pool == nullptr || pool->Size() <= 1 || n <= kMoveChunk) {
+    Move(0, n, inputs);
+  } else {
+    for (int begin = 0; begin < n; begin += kMoveChunk) {
+      int end = std::min(n, begin + kMoveChunk);
+      pool->Submit([this, begin, end, &inputs]() { Move(begin, end, inputs); });
+    }
+    pool->Wait();
+  }
+  Resolve();
+  ++tick_;
+}
+
+void Arena::Move(int begin, int end, const std::vector<SimInput> &inputs) {
+  // Só toca o estado das cobras [begin, end): sem disputa entre tarefas
+  const Snake::Fixed w = static_cast<Snake::Fixed>(width_) << Snake::kFracBits;
+  const Snake::Fixed h = static_cast<Snake::Fixed>(height_) << Snake::kFracBits;
+  for (int i = begin; i < end; ++i) {
+    next_cell_[i] = -1;
+    if (!alive_[i]) continue;
+    if (i < static_cast<int>(inputs.size()) && inputs[i].turn) {
+      std::uint8_t dir = static_cast<std::uint8_t>(inputs[i].direction);
+      if (dir != kOpposite[direction_[i]]) direction_[i] = dir;  // sem inversão, como no jogo
+    }
+    // Ponto fixo, no máximo uma célula por tick: a volta é uma correção só
+    Snake::Fixed x = head_x_[i], y = head_y_[i];
+    switch (static_cast<Snake::Direction>(direction_[i])) {
+      case Snake::Direction::kUp:    y -= speed_[i]; if (y < 0) y += h; break;
+      case Snake::Direction::kDown:  y += speed_[i]; if (y >= h) y -= h; break;
+      case Snake::Direction::kLeft:  x -= speed_[i]; if (x < 0) x += w; break;
+      case Snake::Direction::kRight: x += speed_[i]; if (x >= w) x -= w; break;
+    }
+    head_x_[i] = x;
+    head_y_[i] = y;
+    int cell = static_cast<int>(y >> Snake::kFracBits) * width_ + static_cast<int>(x >> Snake::kFracBits);
+    if (cell != head_cell_[i]) next_cell_[i] = cell;
+  }
+}
+
+void Arena::Resolve() {
+  movers_.clear();
+  for (int i = 0; i < NumSnakes(); ++i) {
+    if (next_cell_[i] >= 0) movers_.push_back(i);
+  }
+  if (movers_.empty()) return;
+  moved_cells_ += movers_.size();
+  if (++stamp_ == 0) {
+    // Carimbo deu a volta: limpa uma vez a cada 2^32 ticks
+    std::fill(claim_stamp_.begin(), claim_stamp_.end(), 0);
+    std::fill(head_stamp_.begin(), head_stamp_.end(), 0);
+    stamp_ = 1;
+  }
+
+  // Cabeças de onde saem, para achar duas cobras trocando de célula
+  for (int i : movers_) {
+    head_stamp_[head_cell_[i]] = stamp_;
+    head_by_[head_cell_[i]] = i;
+  }
+  // Caudas saem antes das cabeças entrarem (pode-se seguir a cauda)
+  for (int i : movers_) {
+    if (growing_[i]) continue;
+    int tail = bodies_[i].front();
+    bodies_[i].pop_front();
+    grid_.Clear(tail % width_, tail / width_, OccupancyGrid::kSnake);
+  }
+
+  // Cabeça contra cabeça: a mesma célula de destino, ou uma entrando onde
+  // a outra estava enquanto a outra entra onde a primeira estava
+  for (int i : movers_) {
+    int target = next_cell_[i];
+    if (claim_stamp_[target] == stamp_) {
+      death_[i] = death_[claim_by_[target]] = ArenaDeath::HeadOn;
+    } else {
+      claim_stamp_[target] = stamp_;
+      claim_by_[target] = i;
+    }
+    if (head_stamp_[target] == stamp_) {
+      int j = head_by_[target];
+      if (j != i && next_cell_[j] == head_cell_[i]) death_[i] = death_[j] = ArenaDeath::HeadOn;
+    }
+  }
+  // Corpo (de qualquer cobra, inclusive as que morrem agora) e obstáculos
+  for (int i : movers_) {
+    if (death_[i] != ArenaDeath::None) continue;
+    int target = next_cell_[i];
+    if (grid_.Has(target % width_, target / width_, OccupancyGrid::kObstacle)) {
+      death_[i] = ArenaDeath::Obstacle;
+    } else if (grid_.Has(target % width_, target / width_, OccupancyGrid::kSnake)) {
+      death_[i] = ArenaDeath::Body;
+    }
+  }
+
+  for (int i : movers_) {
+    if (death_[i] != ArenaDeath::None) {
+      Kill(i, death_[i]);
+      continue;
+    }
+    int target = next_cell_[i];
+    int x = target % width_, y = target / width_;
+    bodies_[i].push_back(target);
+    head_cell_[i] = target;
+    growing_[i] = 0;
+    if (grid_.Has(x, y, OccupancyGrid::kFood)) {
+      grid_.Clear(x, y, OccupancyGrid::kFood);
+      --food_count_;
+      ++score_[i];
+      growing_[i] = 1;
+    }
+    grid_.Set(x, y, OccupancyGrid::kSnake);
+  }
+  RefillFood();
+}
+
+void Arena::Kill(int i, ArenaDeath cause) {
+  // Único passo que percorre um corpo: uma vez por cobra
+  for (int cell : bodies_[i]) grid_.Clear(cell % width_, cell / width_, OccupancyGrid::kSnake);
+  bodies_[i].clear();
+  alive_[i] = 0;
+  death_[i] = cause;
+  --alive_count_;
+}
@@ -0,0 +1,106 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "occupancy_grid.h"
+#include "ring_buffer.h"
+#include "rng.h"
+#include "simulation.h"  // SimInput, Snake::Direction
+#include "thread_pool.h"
+
+enum class ArenaDeath : std::uint8_t { None, Body, HeadOn, Obstacle };
+
+// Muitas cobras (jogador ou IA, cada uma recebe um SimInput por tick) numa
+// grade compartilhada com várias comidas. O estado por cobra fica em
+// arrays paralelos (estrutura de arrays); o corpo de cada uma é um anel de
+// índices de célula, da cauda até a cabeça.
+//
+// Step tem duas fases:
+//  - movimento: cada cobra aplica sua entrada e avança a cabeça; só lê e
+//    escreve as próprias posições, então roda em paralelo no ThreadPool;
+//  - resolução: em série e na ordem dos índices, só para as cobras que
+//    entraram numa célula nova. Caudas saem primeiro; duas cabeças na mesma
+//    célula (ou trocando de célula) morrem as duas; depois valem corpo e
+//    obstáculo da grade. Quem morre sai da grade e a comida é reposta.
+// O resultado não depende do número de threads, e o custo do tick acompanha
+// as células percorridas, não cobras vezes comprimento.
+class Arena {
+ public:
+  // Cobras nascem com tamanho 1 em células livres sorteadas; se a grade
+  // não tiver lugar, nascem menos (NumSnakes). speed: células por tick.
+  // Grade, estado por cobra e corpos alocam de resource (só na thread que
+  // chama Step; a fase paralela não aloca).
+  Arena(int grid_width, int grid_height, int num_snakes, int num_food, int num_obstacles,
+        float speed, std::uint32_t seed,
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // inputs[i] é a entrada da cobra i (as mortas são ignoradas). Com pool,
+  // a fase de movimento é dividida entre as threads.
+  void Step(const std::vector<SimInput> &inputs, ThreadPool *pool = nullptr);
+
+  int NumSnakes() const { return static_cast<int>(alive_.size()); }
+  int AliveCount() const { return alive_count_; }
+  unsigned long Tick() const { return tick_; }
+  // Células percorridas por todas as cobras desde o início
+  std::uint64_t MovedCells() const { return moved_cells_; }
+  const OccupancyGrid &Grid() const { return grid_; }
+
+  bool Alive(int i) const { return alive_[i] != 0; }
+  ArenaDeath Death(int i) const { return death_[i]; }
+  int Score(int i) const { return score_[i]; }
+  int Size(int i) const { return static_cast<int>(bodies_[i].size()); }
+  int HeadCell(int i) const { return head_cell_[i]; }
+  float HeadX(int i) const { return Snake::ToFloat(head_x_[i]); }
+  float HeadY(int i) const { return Snake::ToFloat(head_y_[i]); }
+  Snake::Direction Direction(int i) const { return static_cast<Snake::Direction>(direction_[i]); }
+  const RingBuffer<int> &Body(int i) const { return bodies_[i]; }
+
+ private:
+  static constexpr int kMoveChunk = 256;  // cobras por tarefa na fase paralela
+
+  void Move(int begin, int end, const std::vector<SimInput> &inputs);
+  void Resolve();
+  void Kill(int i, ArenaDeath cause);
+  bool RandomFreeCell(int &cell);
+  void RefillFood();
+
+  int width_;
+  int height_;
+  OccupancyGrid grid_;
+  Rng rng_;
+
+  // Estado por cobra (estrutura de arrays)
+  std::pmr::vector<Snake::Fixed> head_x_;  // Q16, como em Snake
+  std::pmr::vector<Snake::Fixed> head_y_;
+  std::pmr::vector<Snake::Fixed> speed_;
+  std::pmr::vector<std::uint8_t> direction_;
+  std::pmr::vector<std::uint8_t> alive_;
+  std::pmr::vector<std::uint8_t> growing_;
+  std::pmr::vector<int> head_cell_;
+  std::pmr::vector<int> next_cell_;  // célula nova neste tick, -1 se não mudou
+  std::pmr::vector<int> score_;
+  std::pmr::vector<ArenaDeath> death_;
+  std::pmr::vector<RingBuffer<int>> bodies_;
+
+  // Resolução: cobras que mudaram de célula, em ordem de índice, e marcas
+  // por célula válidas só quando o carimbo é o do tick atual
+  std::pmr::vector<int> movers_;
+  std::pmr::vector<std::uint32_t> claim_stamp_;
+  std::pmr::vector<int> claim_by_;   // primeira cabeça a entrar na célula
+  std::pmr::vector<std::uint32_t> head_stamp_;
+  std::pmr::vector<int> head_by_;    // cabeça que estava na célula
+  std::uint32_t stamp_{0};
+
+  int food_target_;
+  int food_count_{0};
+  int alive_count_{0};
+  unsigned long tick_{0};
+  std::uint64_t moved_cells_{0};
+};
+
+#endif  // ARENA_H
@@ -0,0 +1,392 @@
+// snake_batch: roda N partidas independentes em paralelo, sem janela, e
+// agrega pontuação, tamanho e causa da morte. Serve para calibrar os
+// presets de dificuldade e velocidade (settings.h).
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include "arena.h"
+#include "bot.h"
+#include "replay.h"
+#include "rng.h"
+#include "round_arena.h"
+#include "settings.h"
+#include "simulation.h"
+#include "thread_pool.h"
+
+namespace {
+
+struct BatchOptions {
+    int games = 1000;
+    unsigned threads = std::thread::hardware_concurrency();
+    std::uint32_t seed = 1;
+    std::size_t grid_width = 32;
+    std::size_t grid_height = 32;
+    Difficulty difficulty = Difficulty::Medium;
+    SpeedOption speed = SpeedOption::Medium;
+    unsigned long max_ticks = 10 * 60 * Simulation::kTicksPerSecond;  // 10 minutos simulados
+    std::string record_prefix;  // grava cada partida como <prefix>-<i>.replay
+    bool bot = false;           // --policy bot: A* do Bot em vez da gulosa
+    int arena = 0;              // --arena N: uma arena com N cobras em vez de partidas
+    int food = -1;              // comidas na arena (padrão: uma por cobra)
+    bool keep_layout = false;   // todas as partidas com os obstáculos de --seed
+};
+
+struct GameResult {
+    int score = 0;
+    int size = 0;
+    unsigned long ticks = 0;
+    DeathCause cause = DeathCause::None;
+    bool board_full = false;
+};
+
+void PrintUsage() {
+    std::cout << "Usage: snake_batch [--games N] [--threads T] [--seed S]\n"
+                 "                   [--grid W H] [--difficulty easy|medium|hard]\n"
+                 "                   [--speed slow|medium|fast] [--max-ticks M]\n"
+                 "                   [--record PREFIX] [--policy greedy|bot] [--keep-layout]\n"
+                 "                   [--arena N [--food F]]\n";
+}
+
+// Lado da grade: número inteiro de pelo menos 2 células; a grade
+// toda precisa caber no índice int de célula (y * largura + x)
+std::size_t ParseGridSide(const std::string& value) {
+    if (value.empty() || value.size() > 9 || value.find_first_not_of("0123456789") != std::string::npos ||
+        std::stoul(value) < 2) {
+        throw std::invalid_argument("invalid grid size: " + value);
+    }
+    return std::stoul(value);
+}
+
+bool ParseArgs(int argc, char* argv[], BatchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&](const char* name) -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument(std::string("missing value for ") + name);
+            return argv[++i];
+        };
+        if (arg == "--games") {
+            options.games = std::stoi(next("--games"));
+            if (options.games <= 0) throw std::invalid_argument("--games must be positive");
+        } else if (arg == "--threads") {
+            options.threads = static_cast<unsigned>(std::stoul(next("--threads")));
+        } else if (arg == "--seed") {
+            options.seed = static_cast<std::uint32_t>(std::stoul(next("--seed")));
+        } else if (arg == "--grid") {
+            options.grid_width = ParseGridSide(next("--grid"));
+            options.grid_height = ParseGridSide(next("--grid"));
+            if (options.grid_width * options.grid_height > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+                throw std::invalid_argument("grid too large");
+            }
+        } else if (arg == "--max-ticks") {
+            options.max_ticks = std::stoul(next("--max-ticks"));
+        } else if (arg == "--record") {
+            options.record_prefix = next("--record");
+        } else if (arg == "--policy") {
+            std::string value = next("--policy");
+            if (value == "greedy") options.bot = false;
+            else if (value == "bot") options.bot = true;
+            else throw std::invalid_argument("unknown policy: " + value);
+        } else if (arg == "--arena") {
+            options.arena = std::stoi(next("--arena"));
+        } else if (arg == "--food") {
+            options.food = std::stoi(next("--food"));
+        } else if (arg == "--keep-layout") {
+            options.keep_layout = true;
+        } else if (arg == "--difficulty") {
+            std::string value = next("--difficulty");
+            if (value == "easy") options.difficulty = Difficulty::Easy;
+            else if (value == "medium") options.difficulty = Difficulty::Medium;
+            else if (value == "hard") options.difficulty = Difficulty::Hard;
+            else throw std::invalid_argument("unknown difficulty: " + value);
+        } else if (arg == "--speed") {
+            std::string value = next("--speed");
+            if (value == "slow") options.speed = SpeedOption::Slow;
+            else if (value == "medium") options.speed = SpeedOption::Medium;
+            else if (value == "fast") options.speed = SpeedOption::Fast;
+            else throw std::invalid_argument("unknown speed: " + value);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Política simples: vai em direção à comida pelo menor caminho (com volta
+// no grid), evitando a próxima célula se ela for obstáculo ou corpo.
+SimInput GreedyInput(const Simulation& sim, Rng& rng) {
+    const Snake& snake = sim.GetSnake();
+    const OccupancyGrid& grid = sim.Grid();
+    const int w = grid.Width();
+    const int h = grid.Height();
+    const int hx = snake.HeadCellX();
+    const int hy = snake.HeadCellY();
+    const SDL_Point food = sim.GetFood().pos;
+
+    auto wrapped_delta = [](int from, int to, int size) {
+        int d = (to - from + size) % size;
+        return d > size / 2 ? d - size : d;
+    };
+    auto blocked = [&](Snake::Direction dir) {
+        int x = hx, y = hy;
+        switch (dir) {
+            case Snake::Direction::kUp:    y = (y - 1 + h) % h; break;
+            case Snake::Direction::kDown:  y = (y + 1) % h; break;
+            case Snake::Direction::kLeft:  x = (x - 1 + w) % w; break;
+            case Snake::Direction::kRight: x = (x + 1) % w; break;
+        }
+        return grid.Has(x, y, OccupancyGrid::kSnake | OccupancyGrid::kObstacle);
+    };
+
+    // Até 2 rumos para a comida, o atual e as 4 direções: cabe sem alocar
+    std::array<Snake::Direction, 9> preferred;
+    std::size_t count = 0;
+    if (food.x >= 0) {
+        int dx = wrapped_delta(hx, food.x, w);
+        int dy = wrapped_delta(hy, food.y, h);
+        if (dx > 0) preferred[count++] = Snake::Direction::kRight;
+        if (dx < 0) preferred[count++] = Snake::Direction::kLeft;
+        if (dy > 0) preferred[count++] = Snake::Direction::kDown;
+        if (dy < 0) preferred[count++] = Snake::Direction::kUp;
+    }
+    preferred[count++] = snake.direction;
+    Snake::Direction all[] = {Snake::Direction::kUp, Snake::Direction::kDown,
+                              Snake::Direction::kLeft, Snake::Direction::kRight};
+    for (int i = 3; i > 0; --i) {
+        std::swap(all[i], all[rng.UniformInt(static_cast<std::uint32_t>(i + 1))]);
+    }
+    for (Snake::Direction dir : all) preferred[count++] = dir;
+
+    SimInput input;
+    for (std::size_t i = 0; i < count; ++i) {
+        Snake::Direction dir = preferred[i];
+        if (!blocked(dir)) {
+            input.turn = dir != snake.direction;
+            input.direction = dir;
+            break;
+        }
+    }
+    return input;
+}
+
+// Semente por partida derivada da semente base (splitmix32), para que cada
+// jogo tenha seu próprio gerador e o lote seja reprodutível.
+std::uint32_t GameSeed(std::uint32_t base, std::uint32_t index) {
+    std::uint32_t z = base + 0x9E3779B9u * (index + 1);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+// O que cada thread do pool reaproveita entre partidas: a simulação nasce
+// uma vez (com o layout de --seed) e cada partida é um Reset, sem alocar.
+// Reset com Regenerate equivale a uma Simulation nova, então o resultado
+// de cada partida não depende de qual thread a jogou antes.
+struct Worker {
+    explicit Worker(const BatchOptions& options)
+        : sim(options.grid_width, options.grid_height, GetSpeedForOption(options.speed),
+              GetNumObstaclesForDifficulty(options.difficulty, options.grid_width * options.grid_height),
+              options.seed, arena.Resource()),
+          bot(Bot::kDefaultExpansionBudget, arena.Resource()),
+          replay(arena.Resource()) {}
+
+    RoundArena arena;
+    Simulation sim;
+    Bot bot;
+    Replay replay;
+};
+
+GameResult PlayOne(const BatchOptions& options, int index) {
+    thread_local Worker worker(options);
+    Simulation& sim = worker.sim;
+    std::uint32_t seed = GameSeed(options.seed, static_cast<std::uint32_t>(index));
+    sim.Reset(seed, options.keep_layout ? ObstacleLayout::Keep : ObstacleLayout::Regenerate);
+    worker.bot.Reset();
+    Rng policy_rng(seed ^ 0x5bd1e995u);
+    Replay& replay = worker.replay;
+    replay.events.clear();
+    bool record = !options.record_prefix.empty();
+    while (!sim.IsOver() && sim.State().tick < options.max_ticks) {
+        SimInput input = options.bot ? worker.bot.NextInput(sim) : GreedyInput(sim, policy_rng);
+        if (record) replay.Record(sim, input);
+        sim.Step(input);
+    }
+    if (record) {
+        replay.seed = seed;
+        replay.grid_width = static_cast<std::uint32_t>(options.grid_width);
+        replay.grid_height = static_cast<std::uint32_t>(options.grid_height);
+        replay.speed = GetSpeedForOption(options.speed);
+        replay.num_obstacles = GetNumObstaclesForDifficulty(options.difficulty, options.grid_width * options.grid_height);
+        replay.keep_layout = options.keep_layout;
+        replay.layout_seed = options.keep_layout ? options.seed : seed;
+        replay.Finish(sim);
+        SaveReplay(options.record_prefix + "-" + std::to_string(index) + ".replay", replay);
+    }
+    const SimState& state = sim.State();
+    return {state.score, state.size, state.tick, state.death_cause, state.board_full};
+}
+
+double Percentile(std::vector<int> values, double p) {
+    if (values.empty()) return 0.0;
+    std::size_t k = static_cast<std::size_t>(p * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+// IA da arena, O(1) por cobra: vai para uma comida vizinha se houver,
+// senão segue reto e às vezes vira; nunca entra numa célula ocupada se
+// tiver opção. Só lê a arena, então roda em paralelo entre as cobras.
+SimInput ArenaInput(const Arena& arena, int i, Rng& rng) {
+    static const int kDx[4] = {0, 0, -1, 1};
+    static const int kDy[4] = {-1, 1, 0, 0};
+    static const int kOpposite[4] = {1, 0, 3, 2};
+    const OccupancyGrid& grid = arena.Grid();
+    const int w = grid.Width(), h = grid.Height();
+    const int head = arena.HeadCell(i);
+    const int current = static_cast<int>(arena.Direction(i));
+
+    int best = -1, best_rank = -1;
+    for (int d = 0; d < 4; ++d) {
+        if (d == kOpposite[current]) continue;
+        int x = (head % w + kDx[d] + w) % w;
+        int y = (head / w + kDy[d] + h) % h;
+        if (grid.Has(x, y, OccupancyGrid::kSnake | OccupancyGrid::kObstacle)) continue;
+        // comida > reto > virar; empate entre viradas sorteado
+        int rank = grid.Has(x, y, OccupancyGrid::kFood) ? 3 : (d == current ? 2 : 1);
+        if (d == current && rng.UniformInt(16) == 0) rank = 0;
+        if (rank > best_rank || (rank == best_rank && rng.UniformInt(2) == 0)) {
+            best = d;
+            best_rank = rank;
+        }
+    }
+    SimInput input;
+    if (best >= 0 && best != current) {
+        input.turn = true;
+        input.direction = static_cast<Snake::Direction>(best);
+    }
+    return input;
+}
+
+int RunArena(const BatchOptions& options) {
+    const int cells = static_cast<int>(options.grid_width * options.grid_height);
+    RoundArena memory;  // grade, estado das cobras e corpos
+    Arena arena(static_cast<int>(options.grid_width), static_cast<int>(options.grid_height), options.arena,
+                options.food >= 0 ? options.food : options.arena,
+                GetNumObstaclesForDifficulty(options.difficulty, cells), GetSpeedForOption(options.speed),
+                options.seed, memory.Resource());
+    const int n = arena.NumSnakes();
+    std::vector<Rng> rngs;
+    for (int i = 0; i < n; ++i) rngs.emplace_back(GameSeed(options.seed, static_cast<std::uint32_t>(i)));
+    std::vector<SimInput> inputs(n);
+
+    ThreadPool pool(options.threads);
+    const int chunk = 256;
+    auto start = std::chrono::steady_clock::now();
+    while (arena.AliveCount() > 0 && arena.Tick() < options.max_ticks) {
+        // Decisões em paralelo (só leitura), depois o Step resolve em ordem
+        for (int begin = 0; begin < n; begin += chunk) {
+            int end = std::min(n, begin + chunk);
+            pool.Submit([&, begin, end]() {
+                for (int i = begin; i < end; ++i) {
+                    if (arena.Alive(i)) inputs[i] = ArenaInput(arena, i, rngs[i]);
+                }
+            });
+        }
+        pool.Wait();
+        arena.Step(inputs, &pool);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<int> scores, sizes;
+    int body = 0, head_on = 0, obstacle = 0;
+    for (int i = 0; i < n; ++i) {
+        scores.push_back(arena.Score(i));
+        if (arena.Alive(i)) sizes.push_back(arena.Size(i));
+        switch (arena.Death(i)) {
+            case ArenaDeath::Body:     ++body; break;
+            case ArenaDeath::HeadOn:   ++head_on; break;
+            case ArenaDeath::Obstacle: ++obstacle; break;
+            case ArenaDeath::None:     break;
+        }
+    }
+    double score_sum = 0;
+    for (int x : scores) score_sum += x;
+
+    std::cout << "arena: " << n << " snakes on " << options.grid_width << "x" << options.grid_height
+              << "  threads: " << pool.Size() << "  seed: " << options.seed << "\n";
+    std::cout << "ticks " << arena.Tick() << "  alive " << arena.AliveCount() << "  longest alive "
+              << (sizes.empty() ? 0 : *std::max_element(sizes.begin(), sizes.end())) << "\n";
+    std::cout << "score  mean " << (n ? score_sum / n : 0.0) << "  p50 " << Percentile(scores, 0.5) << "  max "
+              << (scores.empty() ? 0 : *std::max_element(scores.begin(), scores.end())) << "\n";
+    std::cout << "deaths body " << body << "  head-on " << head_on << "  obstacle " << obstacle << "\n";
+    std::cout << "time " << seconds << " s  (" << arena.Tick() / seconds << " ticks/s, "
+              << arena.MovedCells() / seconds << " cell moves/s)\n";
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BatchOptions options;
+    try {
+        if (!ParseArgs(argc, argv, options)) {
+            PrintUsage();
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        PrintUsage();
+        return 1;
+    }
+    if (options.arena > 0) return RunArena(options);
+
+    std::vector<GameResult> results(options.games);
+    auto start = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(options.threads);
+        for (int i = 0; i < options.games; ++i) {
+            // Cada tarefa escreve só no seu slot: sem disputa na agregação
+            pool.Submit([&options, &results, i]() { results[i] = PlayOne(options, i); });
+        }
+        pool.Wait();
+        options.threads = pool.Size();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<int> scores, sizes;
+    unsigned long long total_ticks = 0;
+    int self_collisions = 0, obstacle_hits = 0, board_full = 0, timeouts = 0;
+    for (const GameResult& r : results) {
+        scores.push_back(r.score);
+        sizes.push_back(r.size);
+        total_ticks += r.ticks;
+        switch (r.cause) {
+            case DeathCause::SelfCollision: ++self_collisions; break;
+            case DeathCause::Obstacle:      ++obstacle_hits; break;
+            case DeathCause::None:          r.board_full ? ++board_full : ++timeouts; break;
+        }
+    }
+    auto mean = [](const std::vector<int>& v) {
+        double sum = 0;
+        for (int x : v) sum += x;
+        return v.empty() ? 0.0 : sum / v.size();
+    };
+
+    std::cout << "games: " << options.games << "  threads: " << options.threads
+              << "  seed: " << options.seed << "\n";
+    std::cout << "score  mean " << mean(scores) << "  p50 " << Percentile(scores, 0.5)
+              << "  p90 " << Percentile(scores, 0.9) << "  max "
+              << (scores.empty() ? 0 : *std::max_element(scores.begin(), scores.end())) << "\n";
+    std::cout << "length mean " << mean(sizes) << "  p50 " << Percentile(sizes, 0.5)
+              << "  p90 " << Percentile(sizes, 0.9) << "\n";
+    std::cout << "deaths self " << self_collisions << "  obstacle " << obstacle_hits
+              << "  board full " << board_full << "  tick limit " << timeouts << "\n";
+    std::cout << "time " << seconds << " s  (" << options.games / seconds << " games/s, "
+              << total_ticks / seconds << " ticks/s)\n";
+    return 0;
+}
@@ -0,0 +1,184 @@
+#include "bot.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Mesma ordem de Snake::Direction: kUp, kDown, kLeft, kRight
+constexpr int kDx[4] = {0, 0, -1, 1};
+constexpr int kDy[4] = {-1, 1, 0, 0};
+constexpr int kOpposite[4] = {1, 0, 3, 2};
+
+}  // namespace
+
+Bot::Bot(int expansion_budget, std::pmr::memory_resource *resource)
+    : budget_(std::max(expansion_budget, 1)),
+      stamp_(resource),
+      g_(resource),
+      parent_(resource),
+      open_(resource),
+      path_(resource) {}
+
+void Bot::Resize(int width, int height) {
+  width_ = width;
+  height_ = height;
+  std::size_t cells = static_cast<std::size_t>(width) * height;
+  stamp_.assign(cells, 0);
+  g_.assign(cells, 0);
+  parent_.assign(cells, -1);
+  generation_ = 0;
+  // Cada expansão empilha no máximo 4 vizinhos; o caminho não passa do
+  // número de expansões. Reservando isso, a busca nunca aloca.
+  open_.clear();
+  open_.reserve(4 * static_cast<std::size_t>(budget_) + 4);
+  path_.reserve(std::min(cells, static_cast<std::size_t>(budget_) + 1));
+  Reset();
+}
+
+void Bot::Reset() {
+  path_.clear();
+  path_pos_ = 0;
+  path_goal_ = -1;
+  last_head_ = -1;
+}
+
+bool Bot::Blocked(const OccupancyGrid &grid, int cell) const {
+  return grid.Has(cell % width_, cell / width_, OccupancyGrid::kSnake | OccupancyGrid::kObstacle);
+}
+
+int Bot::Neighbor(int cell, int dir) const {
+  int x = (cell % width_ + kDx[dir] + width_) % width_;
+  int y = (cell / width_ + kDy[dir] + height_) % height_;
+  return y * width_ + x;
+}
+
+int Bot::Heuristic(int cell, int goal) const {
+  // Manhattan com volta nas bordas: admissível, então o A* acha o menor caminho
+  int dx = std::abs(cell % width_ - goal % width_);
+  int dy = std::abs(cell / width_ - goal / width_);
+  return std::min(dx, width_ - dx) + std::min(dy, height_ - dy);
+}
+
+bool Bot::NodeAfter(const Node &a, const Node &b) {
+  if (a.f != b.f) return a.f > b.f;
+  if (a.g != b.g) return a.g < b.g;  // empate: o mais avançado primeiro
+  return a.cell > b.cell;
+}
+
+bool Bot::StepToward(int from, int to, Snake::Direction &dir) const {
+  for (int d = 0; d < 4; ++d) {
+    if (Neighbor(from, d) == to) {
+      dir = static_cast<Snake::Direction>(d);
+      return true;
+    }
+  }
+  return false;
+}
+
+void Bot::Plan(const OccupancyGrid &grid, int head, int goal, int forbidden_dir) {
+  path_.clear();
+  path_pos_ = 0;
+  last_expansions_ = 0;
+  if (goal < 0) return;
+  ++searches_;
+
+  if (++generation_ == 0) {
+    // Carimbo deu a volta: limpa uma vez a cada 2^32 buscas
+    std::fill(stamp_.begin(), stamp_.end(), 0);
+    generation_ = 1;
+  }
+  open_.clear();
+  stamp_[head] = generation_;
+  g_[head] = 0;
+  parent_[head] = -1;
+  open_.push_back({Heuristic(head, goal), 0, head});
+
+  int best = head;
+  int best_h = Heuristic(head, goal);
+  bool found = false;
+  int expansions = 0;
+  while (!open_.empty() && expansions < budget_) {
+    std::pop_heap(open_.begin(), open_.end(), NodeAfter);
+    Node node = open_.back();
+    open_.pop_back();
+    if (node.g != g_[node.cell]) continue;  // entrada velha, já melhorada
+    if (node.cell == goal) {
+      found = true;
+      break;
+    }
+    ++expansions;
+    int h = node.f - node.g;
+    if (h < best_h) {
+      best_h = h;
+      best = node.cell;
+    }
+    for (int d = 0; d < 4; ++d) {
+      if (node.cell == head && d == forbidden_dir) continue;  // sem inversão
+      int next = Neighbor(node.cell, d);
+      if (next != goal && Blocked(grid, next)) continue;
+      int g = node.g + 1;
+      if (stamp_[next] == generation_ && g_[next] <= g) continue;
+      stamp_[next] = generation_;
+      g_[next] = g;
+      parent_[next] = node.cell;
+      open_.push_back({g + Heuristic(next, goal), g, next});
+      std::push_heap(open_.begin(), open_.end(), NodeAfter);
+    }
+  }
+  last_expansions_ = expansions;
+
+  // Sem caminho completo dentro do orçamento: vai até o mais próximo achado
+  int target = found ? goal : best;
+  for (int cell = target; cell != head; cell = parent_[cell]) path_.push_back(cell);
+  std::reverse(path_.begin(), path_.end());
+}
+
+SimInput Bot::NextInput(const Simulation &sim) {
+  const Snake &snake = sim.GetSnake();
+  const OccupancyGrid &grid = sim.Grid();
+  if (grid.Width() != width_ || grid.Height() != height_) Resize(grid.Width(), grid.Height());
+
+  int head = snake.HeadCellY() * width_ + snake.HeadCellX();
+  const Food &food = sim.GetFood();
+  int goal = food.pos.x >= 0 ? food.pos.y * width_ + food.pos.x : -1;
+  int forbidden = kOpposite[static_cast<int>(snake.direction)];
+
+  // Replaneja só quando a comida muda, a cabeça sai do caminho ou o
+  // próximo passo ficou bloqueado; senão segue o caminho já calculado
+  bool replan = goal != path_goal_;
+  if (head != last_head_) {
+    if (path_pos_ < path_.size() && path_[path_pos_] == head) {
+      ++path_pos_;
+    } else {
+      replan = true;
+    }
+    last_head_ = head;
+  }
+  if (path_pos_ < path_.size() && Blocked(grid, path_[path_pos_])) replan = true;
+  if (path_pos_ >= path_.size() && !path_.empty()) replan = true;
+  if (replan) {
+    Plan(grid, head, goal, forbidden);
+    path_goal_ = goal;
+  }
+
+  Snake::Direction dir = snake.direction;
+  bool planned = path_pos_ < path_.size() && StepToward(head, path_[path_pos_], dir) &&
+                 static_cast<int>(dir) != forbidden;
+  if (!planned) {
+    // Sem plano: mantém a direção se possível, senão qualquer vizinho livre
+    dir = snake.direction;
+    if (Blocked(grid, Neighbor(head, static_cast<int>(dir)))) {
+      for (int d = 0; d < 4; ++d) {
+        if (d != forbidden && !Blocked(grid, Neighbor(head, d))) {
+          dir = static_cast<Snake::Direction>(d);
+          break;
+        }
+      }
+    }
+  }
+
+  SimInput input;
+  input.turn = dir != snake.direction;
+  input.direction = dir;
+  return input;
+}
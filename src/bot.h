@@ -0,0 +1,72 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "simulation.h"
+
+// Jogador automático: A* na grade de ocupação até a comida, com as bordas
+// dando a volta (como Snake::UpdateHead) e cobra/obstáculos bloqueando.
+// Devolve o mesmo SimInput que o Controller produz.
+//
+// O custo por tick é limitado por um orçamento de expansões, não de tempo,
+// para o bot continuar determinístico (replays, snake_batch). Quando o
+// orçamento acaba, segue o melhor caminho parcial encontrado. Os buffers
+// da busca são alocados uma vez por tamanho de grade e reaproveitados com
+// carimbos de geração, sem limpar nada entre buscas.
+class Bot {
+ public:
+  static constexpr int kDefaultExpansionBudget = 1 << 16;
+
+  // Os buffers da busca alocam de resource
+  explicit Bot(int expansion_budget = kDefaultExpansionBudget,
+               std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  SimInput NextInput(const Simulation &sim);
+
+  // Esquece o caminho planejado (nova partida); mantém os buffers
+  void Reset();
+
+  // Expansões da última busca e quantas buscas foram feitas (diagnóstico)
+  int LastExpansions() const { return last_expansions_; }
+  std::uint64_t Searches() const { return searches_; }
+
+ private:
+  struct Node {
+    int f;
+    int g;
+    int cell;
+  };
+
+  void Resize(int width, int height);
+  bool Blocked(const OccupancyGrid &grid, int cell) const;
+  int Neighbor(int cell, int dir) const;
+  int Heuristic(int cell, int goal) const;
+  void Plan(const OccupancyGrid &grid, int head, int goal, int forbidden_dir);
+  bool StepToward(int from, int to, Snake::Direction &dir) const;
+  static bool NodeAfter(const Node &a, const Node &b);
+
+  int budget_;
+  int width_{0};
+  int height_{0};
+
+  // Buffers por célula, válidos só onde stamp_ == generation_
+  std::pmr::vector<std::uint32_t> stamp_;
+  std::pmr::vector<int> g_;
+  std::pmr::vector<int> parent_;
+  std::uint32_t generation_{0};
+  std::pmr::vector<Node> open_;
+
+  // Caminho atual: células a visitar a partir de path_pos_
+  std::pmr::vector<int> path_;
+  std::size_t path_pos_{0};
+  int path_goal_{-1};
+  int last_head_{-1};
+
+  int last_expansions_{0};
+  std::uint64_t searches_{0};
+};
+
+#endif  // BOT_H
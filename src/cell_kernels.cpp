@@ -0,0 +1,126 @@
+#include "cell_kernels.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CELL_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using FindFn = std::size_t (*)(const std::uint32_t *, std::size_t, std::uint32_t);
+
+std::size_t FindScalar(const std::uint32_t *cells, std::size_t n, std::uint32_t cell) {
+  for (std::size_t i = 0; i < n; ++i) {
+    if (cells[i] == cell) return i;
+  }
+  return n;
+}
+
+#ifdef CELL_KERNELS_X86
+
+// 16 células por volta em quatro comparações; só a volta com acerto
+// procura a posição exata
+__attribute__((target("sse2"))) std::size_t FindSse2(const std::uint32_t *cells, std::size_t n,
+                                                     std::uint32_t cell) {
+  const __m128i key = _mm_set1_epi32(static_cast<int>(cell));
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    const __m128i *p = reinterpret_cast<const __m128i *>(cells + i);
+    __m128i eq0 = _mm_cmpeq_epi32(_mm_loadu_si128(p), key);
+    __m128i eq1 = _mm_cmpeq_epi32(_mm_loadu_si128(p + 1), key);
+    __m128i eq2 = _mm_cmpeq_epi32(_mm_loadu_si128(p + 2), key);
+    __m128i eq3 = _mm_cmpeq_epi32(_mm_loadu_si128(p + 3), key);
+    __m128i any = _mm_or_si128(_mm_or_si128(eq0, eq1), _mm_or_si128(eq2, eq3));
+    if (_mm_movemask_epi8(any) != 0) return i + FindScalar(cells + i, 16, cell);
+  }
+  for (; i + 4 <= n; i += 4) {
+    __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(cells + i)), key);
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+    if (mask != 0) return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+  }
+  return i + FindScalar(cells + i, n - i, cell);
+}
+
+__attribute__((target("avx2"))) std::size_t FindAvx2(const std::uint32_t *cells, std::size_t n,
+                                                     std::uint32_t cell) {
+  const __m256i key = _mm256_set1_epi32(static_cast<int>(cell));
+  std::size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    const __m256i *p = reinterpret_cast<const __m256i *>(cells + i);
+    __m256i eq0 = _mm256_cmpeq_epi32(_mm256_loadu_si256(p), key);
+    __m256i eq1 = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 1), key);
+    __m256i eq2 = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 2), key);
+    __m256i eq3 = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 3), key);
+    __m256i any = _mm256_or_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq2, eq3));
+    if (!_mm256_testz_si256(any, any)) return i + FindScalar(cells + i, 32, cell);
+  }
+  for (; i + 8 <= n; i += 8) {
+    __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(cells + i)), key);
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+    if (mask != 0) return i + static_cast<std::size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+  }
+  return i + FindScalar(cells + i, n - i, cell);
+}
+
+#endif  // CELL_KERNELS_X86
+
+FindFn KernelFn(CellKernel kernel) {
+  switch (kernel) {
+#ifdef CELL_KERNELS_X86
+    case CellKernel::kAvx2: return FindAvx2;
+    case CellKernel::kSse2: return FindSse2;
+#endif
+    default: return FindScalar;
+  }
+}
+
+CellKernel DetectKernel() {
+#ifdef CELL_KERNELS_X86
+  __builtin_cpu_init();  // pode rodar antes de main
+#endif
+  if (CellKernelSupported(CellKernel::kAvx2)) return CellKernel::kAvx2;
+  if (CellKernelSupported(CellKernel::kSse2)) return CellKernel::kSse2;
+  return CellKernel::kScalar;
+}
+
+// Detectada uma vez, na primeira busca
+CellKernel ActiveKernel() {
+  static const CellKernel kernel = DetectKernel();
+  return kernel;
+}
+
+FindFn ActiveFind() {
+  static const FindFn fn = KernelFn(ActiveKernel());
+  return fn;
+}
+
+}  // namespace
+
+bool CellKernelSupported(CellKernel kernel) {
+  switch (kernel) {
+    case CellKernel::kScalar: return true;
+#ifdef CELL_KERNELS_X86
+    case CellKernel::kSse2: return __builtin_cpu_supports("sse2");
+    case CellKernel::kAvx2: return __builtin_cpu_supports("avx2");
+#endif
+    default: return false;
+  }
+}
+
+CellKernel ActiveCellKernel() { return ActiveKernel(); }
+
+const char *CellKernelName(CellKernel kernel) {
+  switch (kernel) {
+    case CellKernel::kSse2: return "sse2";
+    case CellKernel::kAvx2: return "avx2";
+    default: return "scalar";
+  }
+}
+
+std::size_t FindCell(const std::uint32_t *cells, std::size_t n, std::uint32_t cell) {
+  return ActiveFind()(cells, n, cell);
+}
+
+std::size_t FindCellWith(CellKernel kernel, const std::uint32_t *cells, std::size_t n, std::uint32_t cell) {
+  return KernelFn(kernel)(cells, n, cell);
+}
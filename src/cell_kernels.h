@@ -0,0 +1,34 @@
+#ifndef CELL_KERNELS_H
+#define CELL_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Busca de uma célula num array de células empacotadas (índice y * largura
+// + x em 32 bits). É o caminho de quem não tem grade de ocupação, como a
+// cobra solta ou um tabuleiro esparso grande demais para um mapa de bits.
+//
+// A versão é escolhida uma vez em tempo de execução: AVX2 (8 células por
+// comparação), SSE2 (4) ou o laço escalar, que também é o único fora de x86.
+enum class CellKernel { kScalar, kSse2, kAvx2 };
+
+// Célula empacotada; width é a largura da grade
+inline std::uint32_t PackCell(int x, int y, int width) {
+  return static_cast<std::uint32_t>(y) * static_cast<std::uint32_t>(width) + static_cast<std::uint32_t>(x);
+}
+
+// Índice da primeira ocorrência de cell em cells[0, n), ou n se não houver.
+std::size_t FindCell(const std::uint32_t *cells, std::size_t n, std::uint32_t cell);
+
+inline bool ContainsCell(const std::uint32_t *cells, std::size_t n, std::uint32_t cell) {
+  return FindCell(cells, n, cell) != n;
+}
+
+// O mesmo com uma versão fixa (benchmarks); kernel precisa ser suportado
+std::size_t FindCellWith(CellKernel kernel, const std::uint32_t *cells, std::size_t n, std::uint32_t cell);
+
+bool CellKernelSupported(CellKernel kernel);
+CellKernel ActiveCellKernel();  // a usada por FindCell
+const char *CellKernelName(CellKernel kernel);
+
+#endif  // CELL_KERNELS_H
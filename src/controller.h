@@ -1,17 +1,22 @@
 #ifndef CONTROLLER_H
 #define CONTROLLER_H
 
-#include "snake.h"   // Para ter Snake e Snake::Direction
+#include "SDL.h"
+#include "simulation.h"  // Para ter SimInput e Snake::Direction
 class Game;         // Forward declaration para Game
 
 class Controller {
  public:
-  // Remove qualificação Controller:: na declaração
-  void HandleInput(bool &running, Snake &snake, Game &game) const;
+  // Traduz o teclado em SimInput; a regra de não inverter fica na Simulation
+  void HandleInput(bool &running, SimInput &input, Game &game) const;
+
+  // Bloqueia até haver um evento na fila (sem tirá-lo de lá) ou timeout_ms
+  // passar; o próximo HandleInput o trata. Evita gastar CPU entre ticks e
+  // na pausa, e deixa a espera separada do tratamento do input.
+  void WaitForInput(int timeout_ms = 100) const;
 
  private:
-  void ChangeDirection(Snake &snake, Snake::Direction input,
-                       Snake::Direction opposite) const;
+  void HandleEvent(const SDL_Event &e, bool &running, SimInput &input, Game &game) const;
 };
 
 #endif
@@ -0,0 +1,13 @@
+#ifndef FONT5X7_H
+#define FONT5X7_H
+
+// Fonte bitmap 5x7 para ASCII imprimível (' ' a '~').
+// Cada glifo tem 5 colunas; o bit 0 de cada coluna é a linha de cima.
+constexpr int kFontFirstChar = 32;
+constexpr int kFontNumGlyphs = 95;
+constexpr int kFontGlyphWidth = 5;
+constexpr int kFontGlyphHeight = 7;
+
+extern const unsigned char kFont5x7[kFontNumGlyphs][kFontGlyphWidth];
+
+#endif  // FONT5X7_H
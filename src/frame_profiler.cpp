@@ -0,0 +1,154 @@
+#include "frame_profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <utility>
+
+FrameProfiler::FrameProfiler(std::string name, std::size_t capacity)
+    : name_(std::move(name)), origin_(Clock::now()) {
+  std::size_t size = 1;
+  while (size < capacity) size <<= 1;
+  ring_.resize(size);
+  mask_ = size - 1;
+  frame_start_ = last_mark_ = origin_;
+}
+
+std::int64_t FrameProfiler::Nanos(Clock::time_point t) const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(t - origin_).count();
+}
+
+void FrameProfiler::BeginFrame() {
+  frame_start_ = last_mark_ = Clock::now();
+  current_ = Sample{};
+  current_.start_ns = Nanos(frame_start_);
+}
+
+void FrameProfiler::Mark(Phase phase) {
+  Clock::time_point now = Clock::now();
+  current_.phase_ns[static_cast<int>(phase)] +=
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_mark_).count();
+  last_mark_ = now;
+}
+
+void FrameProfiler::EndFrame() {
+  current_.total_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(last_mark_ - frame_start_).count();
+  // Só o produtor escreve written_; o release publica a amostra para Snapshot
+  std::uint64_t n = written_.load(std::memory_order_relaxed);
+  ring_[n & mask_] = current_;
+  written_.store(n + 1, std::memory_order_release);
+}
+
+std::vector<FrameProfiler::Sample> FrameProfiler::Snapshot() const {
+  std::uint64_t end = written_.load(std::memory_order_acquire);
+  std::uint64_t begin = end > ring_.size() ? end - ring_.size() : 0;
+  std::vector<Sample> out;
+  out.reserve(static_cast<std::size_t>(end - begin));
+  for (std::uint64_t i = begin; i < end; ++i) out.push_back(ring_[i & mask_]);
+
+  // Descarta as posições que o produtor pode ter sobrescrito durante a cópia
+  std::uint64_t after = written_.load(std::memory_order_acquire);
+  std::uint64_t safe_begin = after > ring_.size() ? after - ring_.size() + 1 : 0;
+  if (safe_begin > begin) {
+    std::size_t drop = static_cast<std::size_t>(std::min(safe_begin - begin, end - begin));
+    out.erase(out.begin(), out.begin() + drop);
+  }
+  return out;
+}
+
+FrameProfiler::Stats FrameProfiler::Summarize(Phase phase) const {
+  std::vector<Sample> samples = Snapshot();
+  Stats stats;
+  if (samples.empty()) return stats;
+
+  std::vector<std::int64_t> values;
+  values.reserve(samples.size());
+  for (const auto &s : samples) {
+    values.push_back(phase == Phase::kCount ? s.total_ns : s.phase_ns[static_cast<int>(phase)]);
+  }
+  std::sort(values.begin(), values.end());
+
+  auto ms = [](std::int64_t ns) { return ns / 1e6; };
+  auto percentile = [&](double p) {
+    std::size_t index = static_cast<std::size_t>(p * (values.size() - 1) + 0.5);
+    return ms(values[index]);
+  };
+  double sum = 0;
+  for (std::int64_t v : values) sum += v;
+  stats.mean_ms = ms(static_cast<std::int64_t>(sum / values.size()));
+  stats.p50_ms = percentile(0.50);
+  stats.p95_ms = percentile(0.95);
+  stats.p99_ms = percentile(0.99);
+  stats.max_ms = ms(values.back());
+  return stats;
+}
+
+void FrameProfiler::PrintSummary(std::ostream &out) const {
+  std::vector<Sample> samples = Snapshot();
+  out << "\n===== " << name_ << " times (" << samples.size() << " samples, ms) =====\n";
+  if (samples.empty()) return;
+
+  auto row = [&out](const char *name, const Stats &s) {
+    out << std::left << std::setw(9) << name << std::right << std::fixed << std::setprecision(3)
+        << " mean " << std::setw(8) << s.mean_ms
+        << "  p50 " << std::setw(8) << s.p50_ms
+        << "  p95 " << std::setw(8) << s.p95_ms
+        << "  p99 " << std::setw(8) << s.p99_ms
+        << "  max " << std::setw(8) << s.max_ms << "\n";
+  };
+  row("total", Summarize());
+  for (int p = 0; p < kNumPhases; ++p) {
+    bool used = std::any_of(samples.begin(), samples.end(), [p](const Sample &s) { return s.phase_ns[p] != 0; });
+    if (used) row(PhaseName(static_cast<Phase>(p)), Summarize(static_cast<Phase>(p)));
+  }
+  out.unsetf(std::ios::floatfield);
+}
+
+bool FrameProfiler::WriteChromeTrace(const std::string &path, const std::vector<const FrameProfiler *> &profilers) {
+  std::ofstream file(path);
+  if (!file) return false;
+
+  // Cada volta do loop vira um evento com o nome do profiler e as fases
+  // aninhadas, em microssegundos a partir do profiler criado primeiro
+  Clock::time_point origin = Clock::time_point::max();
+  for (const FrameProfiler *profiler : profilers) origin = std::min(origin, profiler->origin_);
+  file << "{\"traceEvents\":[\n";
+  bool first = true;
+  int tid = 0;
+  auto event = [&](const char *name, std::int64_t start_ns, std::int64_t dur_ns) {
+    if (!first) file << ",\n";
+    first = false;
+    file << "{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+         << ",\"ts\":" << start_ns / 1000.0 << ",\"dur\":" << dur_ns / 1000.0 << "}";
+  };
+  file << std::fixed << std::setprecision(3);
+  for (const FrameProfiler *profiler : profilers) {
+    ++tid;
+    const std::int64_t offset_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(profiler->origin_ - origin).count();
+    for (const auto &s : profiler->Snapshot()) {
+      event(profiler->name_.c_str(), offset_ns + s.start_ns, s.total_ns);
+      // As fases são contíguas na ordem do enum, que é a ordem dos loops
+      std::int64_t t = offset_ns + s.start_ns;
+      for (int p = 0; p < kNumPhases; ++p) {
+        if (s.phase_ns[p] == 0) continue;
+        event(PhaseName(static_cast<Phase>(p)), t, s.phase_ns[p]);
+        t += s.phase_ns[p];
+      }
+    }
+  }
+  file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return static_cast<bool>(file);
+}
+
+const char *FrameProfiler::PhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::kInput:    return "input";
+    case Phase::kUpdate:   return "update";
+    case Phase::kSnapshot: return "snapshot";
+    case Phase::kRender:   return "render";
+    case Phase::kPresent:  return "present";
+    case Phase::kSleep:    return "sleep";
+    default:               return "frame";
+  }
+}
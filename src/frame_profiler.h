@@ -0,0 +1,82 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Mede o tempo de cada fase de um loop com steady_clock e guarda as
+// amostras num anel de tamanho fixo. Cada thread tem o seu: a do jogo marca
+// input, update e sleep por volta do loop; a de renderização marca
+// snapshot, render, present e sleep por quadro. Um único produtor escreve
+// sem lock; leitores em outra thread copiam o anel e descartam as amostras
+// sobrescritas durante a cópia.
+class FrameProfiler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Na ordem em que os loops as marcam. kInput: tratar os eventos da fila;
+  // kUpdate: bot, Step e publicar o snapshot de cada tick devido;
+  // kSnapshot: pegar o snapshot mais novo e aplicá-lo à cópia da grade;
+  // kSleep: esperar o próximo tick (ou evento) ou quadro
+  enum class Phase : int { kInput, kUpdate, kSnapshot, kRender, kPresent, kSleep, kCount };
+  static constexpr int kNumPhases = static_cast<int>(Phase::kCount);
+
+  struct Sample {
+    std::int64_t start_ns = 0;  // início do quadro, relativo à criação do profiler
+    std::int64_t total_ns = 0;
+    std::array<std::int64_t, kNumPhases> phase_ns{};
+  };
+
+  struct Stats {
+    double mean_ms = 0, p50_ms = 0, p95_ms = 0, p99_ms = 0, max_ms = 0;
+  };
+
+  // name identifica o loop no resumo e no trace; capacity é arredondada
+  // para potência de dois.
+  explicit FrameProfiler(std::string name = "frame", std::size_t capacity = 1 << 14);
+
+  FrameProfiler(const FrameProfiler&) = delete;
+  FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+  // Chamadas do loop medido: BeginFrame, Mark ao fim de cada fase, EndFrame.
+  // Mark atribui à fase o tempo desde a marca anterior.
+  void BeginFrame();
+  void Mark(Phase phase);
+  void EndFrame();
+
+  // Cópia consistente das amostras mais recentes, da mais antiga à mais nova.
+  std::vector<Sample> Snapshot() const;
+
+  // Estatísticas do quadro inteiro (phase == kCount) ou de uma fase.
+  Stats Summarize(Phase phase = Phase::kCount) const;
+  // Só as fases que o loop marcou
+  void PrintSummary(std::ostream &out) const;
+
+  // Trace no formato do chrome://tracing / Perfetto (eventos "X"), uma
+  // linha (tid) por profiler, todas na mesma escala de tempo.
+  static bool WriteChromeTrace(const std::string &path, const std::vector<const FrameProfiler *> &profilers);
+
+  const std::string &Name() const { return name_; }
+  static const char *PhaseName(Phase phase);
+
+ private:
+  std::int64_t Nanos(Clock::time_point t) const;
+
+  std::string name_;
+  std::vector<Sample> ring_;
+  std::size_t mask_;
+  std::atomic<std::uint64_t> written_{0};  // quadros publicados
+
+  Clock::time_point origin_;
+  Clock::time_point frame_start_;
+  Clock::time_point last_mark_;
+  Sample current_;
+};
+
+#endif  // FRAME_PROFILER_H
@@ -0,0 +1,123 @@
+#include "frame_snapshot.h"
+#include <algorithm>
+
+SnapshotBuffer::SnapshotBuffer(int grid_width, int grid_height, std::pmr::memory_resource *resource)
+    : slots_{FrameSnapshot(resource), FrameSnapshot(resource), FrameSnapshot(resource)},
+      log_(resource),
+      last_change_(resource) {
+  std::size_t cells = static_cast<std::size_t>(grid_width) * grid_height;
+  // Deltas e registro ficam reservados aqui; slot.cells só cresce no
+  // primeiro snapshot completo daquele slot
+  for (FrameSnapshot &slot : slots_) slot.changes.reserve(std::min(cells, kMaxLogEntries));
+  log_.reserve(std::min(cells, kMaxLogEntries));
+  last_change_.assign(cells, 0);
+}
+
+void SnapshotBuffer::Publish(Simulation &sim, bool paused, FrameSnapshot::Clock::time_point tick_time) {
+  if (seq_ == kMaxSeq) Rollover();
+  std::uint32_t seq = ++seq_;
+  const std::pmr::vector<int> &changed = sim.ChangedCells();
+
+  // O que a leitora já aplicou sai do registro. Um seq que não é anterior
+  // a este veio da numeração de antes do Rollover: a leitora fica sem base
+  std::uint32_t base = acquired_seq_.load(std::memory_order_acquire);
+  if (base >= seq) base = 0;
+  while (log_head_ < log_.size() && log_[log_head_].seq <= base) ++log_head_;
+  if (log_head_ == log_.size()) {
+    log_.clear();
+    log_head_ = 0;
+  } else if (log_head_ > 0 && (log_.size() + changed.size() > log_.capacity() ||
+                               (log_head_ > 1024 && 2 * log_head_ > log_.size()))) {
+    log_.erase(log_.begin(), log_.begin() + static_cast<std::ptrdiff_t>(log_head_));
+    log_head_ = 0;
+  }
+  // Leitora muito atrasada (ou o registro não cabe na reserva): mandar a
+  // grade inteira sai mais barato e não aloca
+  std::size_t pending = log_.size() - log_head_ + changed.size();
+  if (pending > last_change_.size() / 4 || log_.size() + changed.size() > log_.capacity()) {
+    full_seq_ = seq;
+    log_.clear();
+    log_head_ = 0;
+  } else {
+    for (int index : changed) log_.push_back({seq, index});
+  }
+  for (int index : changed) last_change_[index] = seq;
+  sim.ClearChangedCells();
+
+  FrameSnapshot &snapshot = slots_[back_];
+  snapshot.seq = seq;
+  snapshot.tick_time = tick_time;
+  snapshot.paused = paused;
+  Fill(snapshot, sim, base);
+
+  int old = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel);
+  back_ = old & ~kFresh;
+}
+
+void SnapshotBuffer::Fill(FrameSnapshot &snapshot, const Simulation &sim, std::uint32_t base) {
+  const Snake &snake = sim.GetSnake();
+  snapshot.head_x = Snake::ToFloat(snake.head_x);
+  snapshot.head_y = Snake::ToFloat(snake.head_y);
+  snapshot.prev_head_x = Snake::ToFloat(snake.prev_head_x);
+  snapshot.prev_head_y = Snake::ToFloat(snake.prev_head_y);
+  snapshot.head_cell_x = snake.HeadCellX();
+  snapshot.head_cell_y = snake.HeadCellY();
+  snapshot.alive = snake.alive;
+  snapshot.food = sim.GetFood();
+  snapshot.bonus_food = sim.GetBonusFood();
+  snapshot.bonus_active = sim.BonusFoodActive();
+  snapshot.score = sim.State().score;
+  snapshot.over = sim.IsOver();
+
+  const std::pmr::vector<std::uint8_t> &cells = sim.Grid().Cells();
+  snapshot.changes.clear();
+  // Sem base comum (início da rodada ou depois de um atraso grande)
+  snapshot.full = base < full_seq_;
+  if (snapshot.full) {
+    snapshot.cells.assign(cells.begin(), cells.end());
+    return;
+  }
+  // Cada célula alterada depois de base uma vez, com as flags de agora
+  for (std::size_t i = log_head_; i < log_.size(); ++i) {
+    const LogEntry &entry = log_[i];
+    if (entry.seq == last_change_[entry.index]) snapshot.changes.push_back({entry.index, cells[entry.index]});
+  }
+}
+
+bool ApplySnapshot(const FrameSnapshot &frame, OccupancyGrid &grid) {
+  const int width = grid.Width();
+  if (frame.full) {
+    for (int index = 0; index < static_cast<int>(frame.cells.size()); ++index) {
+      grid.Replace(index % width, index / width, frame.cells[index]);
+    }
+    return true;
+  }
+  for (const CellChange &change : frame.changes) {
+    grid.Replace(change.index % width, change.index / width, change.flags);
+  }
+  return false;
+}
+
+void SnapshotBuffer::Rollover() {
+  seq_ = 0;
+  full_seq_ = 1;
+  log_.clear();
+  log_head_ = 0;
+  std::fill(last_change_.begin(), last_change_.end(), 0);
+}
+
+void SnapshotBuffer::Reset() {
+  Rollover();
+  back_ = 0;
+  front_ = 1;
+  middle_.store(2, std::memory_order_relaxed);
+  acquired_seq_.store(0, std::memory_order_relaxed);
+}
+
+const FrameSnapshot *SnapshotBuffer::Acquire() {
+  if (!(middle_.load(std::memory_order_acquire) & kFresh)) return nullptr;
+  int old = middle_.exchange(front_, std::memory_order_acq_rel);
+  front_ = old & ~kFresh;
+  acquired_seq_.store(slots_[front_].seq, std::memory_order_release);
+  return &slots_[front_];
+}
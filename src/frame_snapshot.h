@@ -0,0 +1,114 @@
+#ifndef FRAME_SNAPSHOT_H
+#define FRAME_SNAPSHOT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "simulation.h"
+
+// Uma célula da grade com as flags que ela tem no snapshot.
+struct CellChange {
+  int index;
+  std::uint8_t flags;
+};
+
+// O que a thread de renderização precisa de um tick, copiado da
+// Simulation. Corpo e obstáculos vivem na OccupancyGrid, então vão como
+// delta da grade (células alteradas com as flags novas) ou, quando o
+// leitor não tem uma base, como a grade inteira.
+struct FrameSnapshot {
+  using Clock = std::chrono::steady_clock;
+
+  FrameSnapshot() = default;
+  explicit FrameSnapshot(std::pmr::memory_resource *resource) : changes(resource), cells(resource) {}
+
+  std::uint32_t seq{0};
+  Clock::time_point tick_time;  // quando o tick foi simulado (interpolação)
+
+  float head_x{0}, head_y{0};  // em células, só para interpolar
+  float prev_head_x{0}, prev_head_y{0};
+  int head_cell_x{0}, head_cell_y{0};  // exata (o float perde bits em grades grandes)
+  bool alive{true};
+  Food food{{-1, -1}, FoodType::Normal};
+  Food bonus_food{{-1, -1}, FoodType::SpecialScore};
+  bool bonus_active{false};
+  int score{0};
+  bool paused{false};
+  bool over{false};
+
+  // full: cells tem a grade inteira; senão changes tem toda célula que
+  // mudou desde um snapshot que o leitor já aplicou
+  bool full{false};
+  std::pmr::vector<CellChange> changes;
+  std::pmr::vector<std::uint8_t> cells;
+};
+
+// Buffer triplo de snapshots entre a thread do jogo (uma escritora) e a
+// de renderização (uma leitora). Os três FrameSnapshot são reaproveitados;
+// a cópia da grade inteira de cada um só é alocada no primeiro snapshot
+// completo que ele leva (normalmente só um por rodada). Publicar e pegar o
+// mais novo são uma troca atômica de índice cada, sem lock. Snapshots que
+// a leitora não chegou a pegar são descartados, mas o delta do seguinte
+// cobre as células deles.
+class SnapshotBuffer {
+ public:
+  // Snapshots e registro alocam de resource, só na thread da escritora
+  SnapshotBuffer(int grid_width, int grid_height,
+                 std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  SnapshotBuffer(const SnapshotBuffer&) = delete;
+  SnapshotBuffer& operator=(const SnapshotBuffer&) = delete;
+
+  // Escritora: copia o estado atual da simulação e publica. Consome
+  // (ClearChangedCells) o delta da Simulation, que deve estar com
+  // TrackChangedCells ligado.
+  void Publish(Simulation &sim, bool paused, FrameSnapshot::Clock::time_point tick_time);
+
+  // Leitora: o snapshot mais novo, ou nullptr se nada mudou desde a última
+  // chamada. Continua válido até a próxima chamada.
+  const FrameSnapshot *Acquire();
+
+  // Volta ao estado inicial (o próximo Publish manda a grade inteira), sem
+  // realocar. Só com a leitora parada.
+  void Reset();
+
+ private:
+  static constexpr int kFresh = 4;  // bit em middle_: publicado e não lido
+  // Entradas reservadas para o registro (e para changes); quando não cabem,
+  // o snapshot vai com a grade inteira em vez de crescer o vetor
+  static constexpr std::size_t kMaxLogEntries = 4096;
+  // Último seq antes de a numeração recomeçar (Rollover)
+  static constexpr std::uint32_t kMaxSeq = 0xFFFFFFFFu;
+
+  struct LogEntry {
+    std::uint32_t seq;
+    int index;
+  };
+
+  void Fill(FrameSnapshot &snapshot, const Simulation &sim, std::uint32_t base);
+  // Recomeça a numeração de seq; o próximo snapshot vai completo
+  void Rollover();
+
+  FrameSnapshot slots_[3];
+  int back_{0};                  // da escritora
+  int front_{1};                 // da leitora
+  std::atomic<int> middle_{2};   // índice | kFresh
+  std::atomic<std::uint32_t> acquired_seq_{0};  // último seq pego pela leitora
+
+  // Estado da escritora: células alteradas por seq, ainda não confirmadas
+  // pela leitora, e o seq da última alteração de cada célula (32 bits: numa
+  // grade 4096x4096 já são 64 MB)
+  std::uint32_t seq_{0};
+  std::uint32_t full_seq_{1};  // grades inteiras até a leitora pegar este seq
+  std::pmr::vector<LogEntry> log_;
+  std::size_t log_head_{0};
+  std::pmr::vector<std::uint32_t> last_change_;
+};
+
+// Leva uma cópia da grade (mesmo tamanho) ao estado do snapshot. Retorna
+// true se o snapshot trouxe a grade inteira (quem desenha repinta tudo).
+bool ApplySnapshot(const FrameSnapshot &frame, OccupancyGrid &grid);
+
+#endif  // FRAME_SNAPSHOT_H
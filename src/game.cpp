@@ -1,240 +1,123 @@
 #include "game.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <thread>
 #include "SDL.h"
+#include "frame_snapshot.h"
+#include "render_thread.h"
 
-Game::Game(std::size_t grid_width, std::size_t grid_height, const std::string& player_name, float snake_speed, int num_obstacles)
-    : snake(grid_width, grid_height, snake_speed),
+Game::Game(std::size_t grid_width, std::size_t grid_height, const std::string& player_name, float snake_speed, int num_obstacles,
+           std::uint32_t seed, bool autopilot, std::pmr::memory_resource *resource)
+    : sim(grid_width, grid_height, snake_speed, num_obstacles, seed, resource),
       player_name_(player_name),
-      engine(dev()),
-      random_w(0, static_cast<int>(grid_width - 1)),
-      random_h(0, static_cast<int>(grid_height - 1)),
-      num_obstacles_(num_obstacles) {
-  PlaceFood();
-  PlaceObstacles();
+      replay_(resource),
+      snapshots_(static_cast<int>(grid_width), static_cast<int>(grid_height), resource),
+      autopilot_(autopilot),
+      bot_(Bot::kDefaultExpansionBudget, resource) {
+  replay_.seed = seed;
+  replay_.grid_width = static_cast<std::uint32_t>(grid_width);
+  replay_.grid_height = static_cast<std::uint32_t>(grid_height);
+  replay_.speed = snake_speed;
+  replay_.num_obstacles = num_obstacles;
+  replay_.layout_seed = seed;
 }
 
-void Game::Run(Controller const &controller, Renderer &renderer,
-               std::size_t target_frame_duration) {
-  Uint32 title_timestamp = SDL_GetTicks();
-  Uint32 frame_start;
-  Uint32 frame_end;
-  Uint32 frame_duration;
-  int frame_count = 0;
-  bool running = true;
-
-  while (running) {
-    frame_start = SDL_GetTicks();
-
-    // Input sempre processa para permitir pause e quit
-    controller.HandleInput(running, snake, *this);
+void Game::Reset(std::uint32_t seed, ObstacleLayout layout) {
+  sim.Reset(seed, layout);
+  bot_.Reset();
+  paused = false;
+
+  replay_.seed = seed;
+  replay_.keep_layout = layout == ObstacleLayout::Keep;
+  if (!replay_.keep_layout) replay_.layout_seed = seed;
+  replay_.events.clear();
+  replay_.final_tick = 0;
+  replay_.final_score = 0;
+  replay_.final_size = 0;
+}
 
-    if (!snake.alive) {
-      // Game Over: desenha frame final, mensagem e pausa 2s
-      renderer.Render(snake, food, obstacles);
-      renderer.RenderGameOverMessage();
-      SDL_Delay(2000);
-      running = false;
-      break; // pode usar break ou continue; break é mais claro aqui
+void Game::Run(Controller const &controller, Renderer &renderer, std::size_t target_frame_duration,
+               FrameProfiler &sim_profiler, FrameProfiler &render_profiler) {
+  using Clock = std::chrono::steady_clock;
+  using Phase = FrameProfiler::Phase;
+  // Passo fixo da lógica, independente da taxa de quadros
+  const Clock::duration tick = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / Simulation::kTicksPerSecond));
+  // Limita o atraso acumulado depois de uma travada longa
+  const Clock::duration max_frame_time = std::chrono::milliseconds(250);
+
+  // Esta thread só lê input, simula e publica snapshots; desenhar e
+  // apresentar ficam com a RenderThread, então vsync ou GPU lenta não
+  // atrasam ticks nem input
+  snapshots_.Reset();
+  sim.TrackChangedCells(true);
+  snapshots_.Publish(sim, paused, Clock::now());
+  RenderThread render_thread(renderer, snapshots_, render_profiler, sim.Grid().Width(), sim.Grid().Height(),
+                             target_frame_duration);
+
+  Clock::time_point next_tick = Clock::now() + tick;
+  Clock::time_point title_timestamp = Clock::now();
+  bool running = true;
+  bool published_paused = paused;
+  SimInput input;  // guarda a última direção até o próximo tick
+
+  while (running && !sim.IsOver()) {
+    // Cada volta: input, os ticks devidos e a espera pelo próximo tick ou
+    // evento, medidos à parte (uma travada do PlaceFood aparece em update)
+    sim_profiler.BeginFrame();
+    controller.HandleInput(running, input, *this);
+    sim_profiler.Mark(Phase::kInput);
+
+    Clock::time_point now = Clock::now();
+    if (paused != published_paused) {
+      // Entrou ou saiu da pausa: a renderização mostra/tira o overlay e os
+      // ticks recomeçam a contar da saída
+      published_paused = paused;
+      snapshots_.Publish(sim, paused, now);
+      next_tick = now + tick;
     }
-
     if (!paused) {
-      Update();
-      renderer.Render(snake, food, obstacles);
-    } else {
-      renderer.RenderPauseOverlay(); // Overlay PAUSED
+      if (now - next_tick > max_frame_time) next_tick = now - max_frame_time;
+      while (next_tick <= now && !sim.IsOver()) {
+        if (autopilot_) input = bot_.NextInput(sim);
+        replay_.Record(sim, input);
+        sim.Step(input);
+        input = SimInput{};
+        snapshots_.Publish(sim, paused, now);
+        next_tick += tick;
+      }
     }
-
-    frame_end = SDL_GetTicks();
-
-    frame_count++;
-    frame_duration = frame_end - frame_start;
-
-    if (frame_end - title_timestamp >= 1000) {
-      renderer.UpdateWindowTitle(score, frame_count);
-      frame_count = 0;
-      title_timestamp = frame_end;
+    sim_profiler.Mark(Phase::kUpdate);
+
+    if (now - title_timestamp >= std::chrono::seconds(1)) {
+      int frames, draw_calls;
+      float frame_ms;
+      render_thread.TakeStats(frames, frame_ms, draw_calls);
+      renderer.UpdateWindowTitle(GetScore(), frames, draw_calls, frame_ms);
+      title_timestamp = now;
     }
 
-    if (frame_duration < target_frame_duration) {
-      SDL_Delay(target_frame_duration - frame_duration);
+    // Espera eventos até o próximo tick (na pausa, sem prazo curto)
+    if (running && !sim.IsOver()) {
+      int timeout_ms = 100;
+      if (!paused) {
+        auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(next_tick - Clock::now()).count();
+        timeout_ms = static_cast<int>(std::max<long long>(0, (remaining + 999) / 1000));
+      }
+      if (timeout_ms > 0) controller.WaitForInput(timeout_ms);
     }
+    sim_profiler.Mark(Phase::kSleep);
+    sim_profiler.EndFrame();
   }
-}
-
-void Game::PlaceFood() {
-    int x, y;
-    while (true) {
-        x = random_w(engine);
-        y = random_h(engine);
-
-        // Check that the location is not occupied by snake or obstacle
-        if (!snake.SnakeCell(x, y)) {
-            bool conflict = false;
-            for (const auto& obs : obstacles)
-                if (obs.x == x && obs.y == y)
-                    conflict = true;
-            if (!conflict)
-                break;
-        }
-    }
-
-    // Escolha do tipo de comida
-    static int foods_eaten = 0; // static para manter contagem entre chamadas
-    foods_eaten++;
-    FoodType type = FoodType::Normal;
-
-    if (foods_eaten % 5 == 0) {
-        type = FoodType::SpecialScore; // a cada 5 comidas, vermelha
-    } else {
-        int r = rand() % 10;
-        if (r == 0) type = FoodType::SpeedUp; // ~10% chance rosa
-        else if (r == 1) type = FoodType::SlowDown; // ~10% chance branca
-        // senão, normal (amarela)
-    }
-
-    food.pos.x = x;
-    food.pos.y = y;
-    food.type = type;
-}
-
-void Game::Update() {
-    // Atualiza a posição da Snake a cada frame
-    snake.Update();
-
-    int new_x = static_cast<int>(snake.head_x);
-    int new_y = static_cast<int>(snake.head_y);
-
-    // Checa colisão com obstáculos
-    for (const auto& obs : obstacles) {
-        if (new_x == obs.x && new_y == obs.y) {
-            snake.alive = false;
-            break;
-        }
-    }
-
-    // Checa se pegou comida normal
-    if (food.pos.x == new_x && food.pos.y == new_y) {
-        switch (food.type) {
-            case FoodType::Normal:
-                score += 1;
-                snake.GrowBody();
-                break;
-            case FoodType::SpecialScore:
-                score += 5;
-                snake.GrowBody();
-                snake.GrowBody(); // crescimento duplo
-                break;
-            case FoodType::SpeedUp:
-                score += 1;
-                snake.speed *= 1.5f; // aumenta velocidade
-                speed_timer = 30 * 60; // 30 segundos em frames (60fps)
-                speed_effect = 1.5f;
-                break;
-            case FoodType::SlowDown:
-                score += 1;
-                snake.speed *= 0.5f; // diminui velocidade
-                speed_timer = 30 * 60;
-                speed_effect = 0.5f;
-                break;
-        }
-        PlaceFood();
-    }
-
-    // Checa se pegou a comida bônus (thread, mutex, condition_variable)
-    {
-        std::lock_guard<std::mutex> lock(bonus_mutex);
-        if (bonus_food_active && bonus_food.pos.x == new_x && bonus_food.pos.y == new_y) {
-            score += 10; // valor do bônus, pode ajustar
-            bonus_food_active = false;
-            bonus_cv.notify_all();
-            // Remove bônus do grid
-            bonus_food.pos.x = -1;
-            bonus_food.pos.y = -1;
-        }
-    }
-
-    // Ativa o bônus a cada 10 pontos (pode ajustar a regra)
-    if (score > 0 && score % 10 == 0 && !bonus_food_active) {
-        StartBonusFoodThread();
-    }
-
-    // Reseta efeito temporário de velocidade, se necessário
-    if (speed_timer > 0) {
-        speed_timer--;
-        if (speed_timer == 0) {
-            snake.speed /= speed_effect; // retorna ao normal
-            speed_effect = 1.0f;
-        }
-    }
-}
-
-void Game::PlaceObstacles() {
-    obstacles.clear();
-    int placed = 0;
-    while (placed < num_obstacles_) {
-        int x = random_w(engine);
-        int y = random_h(engine);
 
-        // Avoid snake start position and food position
-        bool conflict = false;
-        if (snake.SnakeCell(x, y) || (food.pos.x == x && food.pos.y == y)) {
-            conflict = true;
-        }
-        for (const auto& obs : obstacles) {
-            if (obs.x == x && obs.y == y) {
-                conflict = true;
-                break;
-            }
-        }
-        if (!conflict) {
-            obstacles.push_back({x, y});
-            placed++;
-        }
-    }
-}
-
-int Game::GetScore() const { return score; }
-int Game::GetSize() const { return snake.size; }
-
-void Game::StartBonusFoodThread() {
-    if (bonus_food_active) return; // Já existe um bônus ativo
-    PlaceBonusFood();
-    bonus_food_active = true;
-    // Thread controlando tempo de vida do bônus
-    bonus_food_thread = std::thread(&Game::BonusFoodTimer, this);
-    bonus_food_thread.detach(); // Pode ser join se quiser controlar o ciclo
-}
-
-void Game::BonusFoodTimer() {
-    std::unique_lock<std::mutex> lock(bonus_mutex);
-    if (bonus_cv.wait_for(lock, std::chrono::seconds(15), [this](){ return !bonus_food_active; })) {
-        // Comida bônus foi consumida, thread encerra
-        return;
-    }
-    // Tempo acabou, remover comida bônus
-    bonus_food_active = false;
-    // Opcional: resetar posição para fora do grid
-    bonus_food.pos.x = -1;
-    bonus_food.pos.y = -1;
+  if (sim.IsOver()) {
+    // Game Over (ou tabuleiro cheio): o último snapshot já pede o overlay
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+  }
+  render_thread.Stop();
+  replay_.Finish(sim);
 }
 
-void Game::PlaceBonusFood() {
-    std::lock_guard<std::mutex> lock(bonus_mutex);
-    int x, y;
-    while (true) {
-        x = random_w(engine);
-        y = random_h(engine);
-        // Garante que não ocupa comida normal, obstáculos ou snake
-        if (!snake.SnakeCell(x, y) && !(food.pos.x == x && food.pos.y == y)) {
-            bool conflict = false;
-            for (const auto& obs : obstacles)
-                if (obs.x == x && obs.y == y)
-                    conflict = true;
-            if (!conflict)
-                break;
-        }
-    }
-    bonus_food.pos.x = x;
-    bonus_food.pos.y = y;
-    bonus_food.type = FoodType::SpecialScore; // Ou um tipo novo se quiser
-}
+int Game::GetScore() const { return sim.State().score; }
+int Game::GetSize() const { return sim.GetSnake().size; }
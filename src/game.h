@@ -1,39 +1,46 @@
 #ifndef GAME_H
 #define GAME_H
 
-#include <random>
+#include <cstdint>
+#include <memory_resource>
 #include <string>
-#include <vector>
-#include <thread>
-#include <mutex>
-#include <condition_variable>
 #include "SDL.h"
+#include "bot.h"
 #include "controller.h"
+#include "frame_profiler.h"
+#include "frame_snapshot.h"
 #include "renderer.h"
-#include "snake.h"
+#include "replay.h"
+#include "simulation.h"
 
 class Renderer;
 
-// Enum para tipos de comida
-enum class FoodType { Normal, SpecialScore, SpeedUp, SlowDown };
-
-// Estrutura para comida
-struct Food {
-    SDL_Point pos;
-    FoodType type;
-};
-
 class Game {
  public:
-  Game(std::size_t grid_width, std::size_t grid_height, const std::string& player_name, float snake_speed, int num_obstacles);
-
-  // Rodar o jogo principal
-  void Run(Controller const &controller, Renderer &renderer,
-           std::size_t target_frame_duration);
+  // Tudo o que o jogo aloca (simulação, bot, replay, snapshots) vem de
+  // resource, em main uma RoundArena; as rodadas seguintes usam Reset
+  Game(std::size_t grid_width, std::size_t grid_height, const std::string& player_name, float snake_speed, int num_obstacles,
+       std::uint32_t seed, bool autopilot = false,
+       std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  // Nova rodada sem reconstruir nada: simulação, bot, replay e pausa
+  // voltam ao início com a semente nova, nos mesmos buffers. Keep mantém
+  // os obstáculos da rodada anterior.
+  void Reset(std::uint32_t seed, ObstacleLayout layout = ObstacleLayout::Regenerate);
+
+  // Rodar o jogo principal; cada volta do loop do jogo (input, update,
+  // espera) vai para sim_profiler e cada quadro da renderização para
+  // render_profiler
+  void Run(Controller const &controller, Renderer &renderer, std::size_t target_frame_duration,
+           FrameProfiler &sim_profiler, FrameProfiler &render_profiler);
 
   // Getters
   int GetScore() const;
   int GetSize() const;
+  std::uint32_t GetSeed() const { return sim.Seed(); }
+
+  // Semente, configurações e viradas da partida, para SaveReplay
+  const Replay &GetReplay() const { return replay_; }
 
   // Pause control
   bool IsPaused() const { return paused; }
@@ -41,37 +48,16 @@ class Game {
   void TogglePause() { paused = !paused; }
 
  private:
-  Snake snake;
-  Food food;
-  Food bonus_food;
-  bool bonus_food_active{false};
-  std::thread bonus_food_thread;
-  std::mutex bonus_mutex;
-  std::condition_variable bonus_cv;
-
-  std::random_device dev;
-  std::mt19937 engine;
-  std::uniform_int_distribution<int> random_w;
-  std::uniform_int_distribution<int> random_h;
+  Simulation sim;
   std::string player_name_;
-  std::vector<SDL_Point> obstacles;
+  Replay replay_;
+  SnapshotBuffer snapshots_;  // reaproveitado a cada Run
 
-  int score{0};
-  int num_obstacles_;
+  // Modo bot: o Bot decide a direção a cada tick; o teclado só pausa/sai
+  bool autopilot_;
+  Bot bot_;
 
   bool paused = false;
-
-  void PlaceFood();
-  void Update();
-  void PlaceObstacles();
-  void StartBonusFoodThread();
-  void BonusFoodTimer();
-  void PlaceBonusFood();
-  
-  int speed_timer{0};
-  float speed_effect{1.0f};
-
-  std::vector<SDL_Point> body;
 };
 
 #endif
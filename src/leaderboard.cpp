@@ -0,0 +1,78 @@
+#include "leaderboard.h"
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+Leaderboard::Leaderboard(std::size_t capacity)
+    : capacity_(capacity), threshold_(std::numeric_limits<std::int64_t>::min()) {
+  // Capacidade fixa: push/pop nunca realocam
+  for (auto &heap : heaps_) heap.reserve(capacity_ + 1);
+}
+
+// Ordem do heap: true se a está "acima" de b, ou seja, b é pior
+bool Leaderboard::Worse(const Entry &a, const Entry &b) {
+  if (a.record.score != b.record.score) return a.record.score > b.record.score;
+  return a.seq < b.seq;
+}
+
+void Leaderboard::Apply(std::vector<Entry> &heap, const Entry &entry) const {
+  heap.push_back(entry);
+  std::push_heap(heap.begin(), heap.end(), Worse);
+  if (heap.size() > capacity_) {
+    std::pop_heap(heap.begin(), heap.end(), Worse);
+    heap.pop_back();
+  }
+}
+
+// Depois de virar front_: garante que nenhum leitor ainda está na
+// instância antiga. Alterna version_ para que leitores novos não segurem
+// a espera indefinidamente.
+void Leaderboard::WaitForReaders() {
+  int old_version = version_.load();
+  int next_version = 1 - old_version;
+  while (read_indicators_[next_version].count.load() != 0) std::this_thread::yield();
+  version_.store(next_version);
+  while (read_indicators_[old_version].count.load() != 0) std::this_thread::yield();
+}
+
+bool Leaderboard::Submit(const ScoreRecord &record) {
+  if (capacity_ == 0) return false;
+  // Caminho rápido: não supera o pior do top-K cheio
+  if (record.score <= threshold_.load(std::memory_order_acquire)) return false;
+
+  std::lock_guard<std::mutex> lock(write_mutex_);
+  // Com o lock, as duas instâncias são iguais
+  int back = 1 - front_.load();
+  std::vector<Entry> &heap = heaps_[back];
+  if (heap.size() == capacity_ && record.score <= heap.front().record.score) return false;
+
+  Entry entry{record, next_seq_++};
+  Apply(heap, entry);
+  front_.store(back);
+  WaitForReaders();
+  Apply(heaps_[1 - back], entry);
+  if (heap.size() == capacity_) {
+    threshold_.store(heap.front().record.score, std::memory_order_release);
+  }
+  return true;
+}
+
+Leaderboard::Snapshot Leaderboard::Current() const {
+  Snapshot snapshot;
+  snapshot.heap.reserve(capacity_);
+  int version = version_.load();
+  read_indicators_[version].count.fetch_add(1);
+  const std::vector<Entry> &heap = heaps_[front_.load()];
+  snapshot.heap.assign(heap.begin(), heap.end());
+  read_indicators_[version].count.fetch_sub(1);
+  return snapshot;
+}
+
+std::vector<ScoreRecord> Leaderboard::Sorted() const {
+  std::vector<Entry> entries = Current().heap;
+  std::sort(entries.begin(), entries.end(), Worse);
+  std::vector<ScoreRecord> result;
+  result.reserve(entries.size());
+  for (const Entry &entry : entries) result.push_back(entry.record);
+  return result;
+}
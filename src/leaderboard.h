@@ -0,0 +1,72 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "score_log.h"
+
+// As K melhores pontuações, compartilhadas entre threads. Usa a técnica
+// left-right: duas instâncias do min-heap de tamanho K, uma que os leitores
+// enxergam e outra que o escritor altera. Quem insere faz push/pop
+// (O(log K), sem alocar) na instância de trás, vira o ponteiro dos
+// leitores para ela, espera os leitores que ainda estavam na antiga saírem
+// e repete a mesma operação nela. Escritores se serializam num mutex;
+// leitores nunca esperam: marcam presença num contador atômico, leem a
+// instância da frente e saem (wait-free).
+//
+// Pontuações que não entram no top-K cheio são rejeitadas sem lock,
+// comparando com o mínimo publicado em threshold_.
+class Leaderboard {
+ public:
+  struct Entry {
+    ScoreRecord record;
+    std::uint64_t seq;  // ordem de chegada: nos empates, o mais antigo fica à frente
+  };
+
+  struct Snapshot {
+    std::vector<Entry> heap;  // min-heap: heap.front() é o pior do top-K
+  };
+
+  explicit Leaderboard(std::size_t capacity);
+
+  Leaderboard(const Leaderboard&) = delete;
+  Leaderboard& operator=(const Leaderboard&) = delete;
+
+  // Retorna true se o registro entrou no top-K.
+  bool Submit(const ScoreRecord &record);
+
+  // Cópia consistente do estado atual; não bloqueia nem espera escritores.
+  Snapshot Current() const;
+
+  // Cópia em ordem decrescente de pontuação.
+  std::vector<ScoreRecord> Sorted() const;
+
+  std::size_t Capacity() const { return capacity_; }
+
+ private:
+  static bool Worse(const Entry &a, const Entry &b);
+  void Apply(std::vector<Entry> &heap, const Entry &entry) const;
+  void WaitForReaders();
+
+  // Contadores de leitores em linhas de cache separadas
+  struct alignas(64) ReadIndicator {
+    std::atomic<std::uint64_t> count{0};
+  };
+
+  const std::size_t capacity_;
+  std::vector<Entry> heaps_[2];
+  std::atomic<int> front_{0};    // instância que os leitores leem
+  std::atomic<int> version_{0};  // qual read_indicators_ novos leitores usam
+  mutable ReadIndicator read_indicators_[2];
+  // Pior pontuação do top-K cheio (ou o mínimo de int64 enquanto não
+  // encheu); só cresce, então um valor atrasado no máximo deixa passar
+  // para o caminho com lock
+  std::atomic<std::int64_t> threshold_;
+  std::mutex write_mutex_;
+  std::uint64_t next_seq_ = 0;  // protegido por write_mutex_
+};
+
+#endif  // LEADERBOARD_H
@@ -0,0 +1,168 @@
+// leaderboard_bench: N inserções no Leaderboard vindas de várias threads,
+// com uma thread lendo snapshots ao mesmo tempo. Compara com o esquema
+// antigo do ScoreManager (mutex + push + sort + resize) e confere que o
+// top-K final é o mesmo de uma execução sequencial.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "leaderboard.h"
+
+namespace {
+
+struct BenchOptions {
+    std::size_t inserts = 1000000;
+    unsigned threads = std::max(2u, std::thread::hardware_concurrency());
+    std::size_t k = 100;
+    bool ascending = false;  // pior caso: toda inserção entra no top-K
+};
+
+void PrintUsage() {
+    std::cout << "Usage: leaderboard_bench [--inserts N] [--threads T] [--k K]\n"
+                 "                         [--pattern random|ascending]\n";
+}
+
+bool ParseArgs(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&](const char* name) -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument(std::string("missing value for ") + name);
+            return argv[++i];
+        };
+        if (arg == "--inserts") {
+            options.inserts = std::stoul(next("--inserts"));
+        } else if (arg == "--threads") {
+            options.threads = static_cast<unsigned>(std::stoul(next("--threads")));
+        } else if (arg == "--k") {
+            options.k = std::stoul(next("--k"));
+        } else if (arg == "--pattern") {
+            std::string value = next("--pattern");
+            if (value == "random") options.ascending = false;
+            else if (value == "ascending") options.ascending = true;
+            else throw std::invalid_argument("unknown pattern: " + value);
+        } else if (arg == "--help" || arg == "-h") {
+            return false;
+        } else {
+            throw std::invalid_argument("unknown option: " + arg);
+        }
+    }
+    if (options.threads == 0) options.threads = 1;
+    return true;
+}
+
+// Pontuação da i-ésima inserção, igual em qualquer número de threads
+int ScoreFor(const BenchOptions& options, std::size_t i) {
+    if (options.ascending) return static_cast<int>(i);
+    std::uint32_t z = static_cast<std::uint32_t>(i) * 0x9E3779B9u;
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return static_cast<int>((z ^ (z >> 16)) % 1000000);
+}
+
+// Roda insert(i) para todo i em [0, inserts) repartido entre as threads,
+// com um leitor contínuo; devolve segundos e o número de leituras feitas.
+double RunParallel(const BenchOptions& options, const std::function<void(std::size_t)>& insert,
+                   const std::function<void()>& read, std::uint64_t& reads) {
+    std::atomic<bool> done{false};
+    std::atomic<std::uint64_t> read_count{0};
+    std::thread reader([&]() {
+        std::uint64_t n = 0;
+        while (!done.load(std::memory_order_relaxed)) {
+            read();
+            ++n;
+        }
+        read_count = n;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> writers;
+    for (unsigned t = 0; t < options.threads; ++t) {
+        writers.emplace_back([&, t]() {
+            for (std::size_t i = t; i < options.inserts; i += options.threads) insert(i);
+        });
+    }
+    for (auto& w : writers) w.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    done = true;
+    reader.join();
+    reads = read_count;
+    return seconds;
+}
+
+void Report(const char* name, const BenchOptions& options, double seconds, std::uint64_t reads) {
+    std::cout << name << ": " << seconds * 1000 << " ms  ("
+              << options.inserts / seconds / 1e6 << " M inserts/s, "
+              << reads / seconds / 1e3 << " k snapshot reads/s)\n";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    try {
+        if (!ParseArgs(argc, argv, options)) {
+            PrintUsage();
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        PrintUsage();
+        return 1;
+    }
+    std::cout << "inserts: " << options.inserts << "  writer threads: " << options.threads
+              << "  k: " << options.k << "  pattern: " << (options.ascending ? "ascending" : "random") << "\n";
+
+    // Nomes pré-montados para não medir a formatação
+    std::vector<ScoreRecord> records(options.inserts);
+    for (std::size_t i = 0; i < options.inserts; ++i) {
+        records[i] = MakeScoreRecord("p" + std::to_string(i), ScoreFor(options, i), 0);
+    }
+
+    std::uint64_t reads = 0;
+    Leaderboard board(options.k);
+    double seconds = RunParallel(
+        options, [&](std::size_t i) { board.Submit(records[i]); },
+        [&]() { (void)board.Current(); }, reads);
+    Report("leaderboard (left-right)   ", options, seconds, reads);
+
+    // Esquema antigo: mutex, push, sort completo e resize a cada inserção
+    std::mutex mutex;
+    std::vector<ScoreRecord> sorted;
+    auto by_score = [](const ScoreRecord& a, const ScoreRecord& b) { return b.score < a.score; };
+    seconds = RunParallel(
+        options,
+        [&](std::size_t i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            sorted.push_back(records[i]);
+            std::sort(sorted.begin(), sorted.end(), by_score);
+            if (sorted.size() > options.k) sorted.resize(options.k);
+        },
+        [&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<ScoreRecord> copy = sorted;
+            (void)copy;
+        },
+        reads);
+    Report("mutex + sort (baseline)     ", options, seconds, reads);
+
+    // As pontuações do top-K precisam bater com a referência sequencial
+    std::vector<int> expected;
+    for (const auto& r : records) expected.push_back(r.score);
+    std::sort(expected.rbegin(), expected.rend());
+    expected.resize(std::min(expected.size(), options.k));
+    std::vector<int> got;
+    for (const auto& r : board.Sorted()) got.push_back(r.score);
+    if (got != expected) {
+        std::cerr << "MISMATCH: leaderboard top-K differs from sequential reference\n";
+        return 2;
+    }
+    std::cout << "top-K verified (best " << (got.empty() ? 0 : got.front()) << ")\n";
+    return 0;
+}
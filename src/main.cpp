@@ -1,9 +1,17 @@
 #include "game.h"
 #include "renderer.h"
 #include "controller.h"
+#include "frame_profiler.h"
 #include "score_manager.h"
+#include "replay.h"
+#include "round_arena.h"
+#include "settings.h"
+#include <algorithm>
 #include <iostream>
+#include <cstdint>
 #include <limits>
+#include <random>
+#include <stdexcept>
 #include <string>
 
 // Utility function: robust menu input validation
@@ -36,16 +44,21 @@ float AskInitialSpeed() {
     int speedOption = AskOption("Enter the option number: ", 1, 3);
 
     switch (speedOption) {
-        case 1:  return 0.07f; // Slow
-        case 2:  return 0.10f; // Medium
-        case 3:  return 0.16f; // Fast
-        default: return 0.10f; // Should never happen
+        case 1:  return GetSpeedForOption(SpeedOption::Slow);
+        case 2:  return GetSpeedForOption(SpeedOption::Medium);
+        case 3:  return GetSpeedForOption(SpeedOption::Fast);
+        default: return GetSpeedForOption(SpeedOption::Medium); // Should never happen
     }
 }
 
-// Difficulty enum and helpers
-enum class Difficulty { Easy, Medium, Hard };
+// Player mode: a human at the keyboard or the built-in A* bot
+bool AskAutopilot() {
+    std::cout << "Select player:\n";
+    std::cout << "1 - Human\n2 - Bot (autopilot)\n";
+    return AskOption("Enter the option number: ", 1, 2) == 2;
+}
 
+// Difficulty helpers (presets live in settings.h)
 Difficulty AskDifficulty() {
     std::cout << "Select game difficulty:\n";
     std::cout << "1 - Easy\n2 - Medium\n3 - Hard\n";
@@ -59,22 +72,98 @@ Difficulty AskDifficulty() {
     }
 }
 
-int GetNumObstaclesForDifficulty(Difficulty diff) {
-    switch (diff) {
-        case Difficulty::Easy:   return 5;
-        case Difficulty::Medium: return 15;
-        case Difficulty::Hard:   return 30;
-        default: return 10;
+// Command line options. --seed makes every round reproducible: round i
+// uses seed + i, and each round's seed is printed so it can be replayed.
+// --trace writes the game-loop and render-frame phase timings as a Chrome trace on exit.
+// --record PREFIX saves each round as PREFIX-<seed>.replay (see snake_replay).
+// --grid, --screen and --cell size the board and window; grids that do not
+// fit on screen get a camera that follows the head.
+// --keep-layout keeps the first round's obstacles in every later round.
+struct CommandLine {
+    bool has_seed = false;
+    std::uint32_t seed = 0;
+    std::string trace_path;
+    std::string record_prefix;
+    std::size_t grid_width = 32;
+    std::size_t grid_height = 32;
+    std::size_t screen_width = 640;
+    std::size_t screen_height = 640;
+    std::size_t cell_size = 0;  // 0 = fit the grid on screen
+    bool keep_layout = false;   // every round keeps the first round's obstacles
+};
+
+void PrintUsage() {
+    std::cerr << "Usage: SnakeGame [--seed N] [--trace FILE] [--record PREFIX]\n"
+              << "                 [--grid W H] [--screen W H] [--cell PX] [--keep-layout]\n";
+}
+
+// Limits for --screen and --cell; the window and cell rectangles are int
+constexpr unsigned long long kMaxScreenSide = 16384;
+constexpr unsigned long long kMaxCellSize = 1024;
+
+// Decimal number in [min, max]. Signs, letters and out-of-range values throw
+// std::invalid_argument naming the option.
+unsigned long long ParseNumber(const std::string& value, const char* option, unsigned long long min,
+                               unsigned long long max) {
+    if (value.empty() || value.size() > 19 || value.find_first_not_of("0123456789") != std::string::npos ||
+        std::stoull(value) < min || std::stoull(value) > max) {
+        throw std::invalid_argument(std::string("invalid value for ") + option + ": " + value);
+    }
+    return std::stoull(value);
+}
+
+// Throws std::invalid_argument on a bad value
+CommandLine ParseCommandLine(int argc, char* argv[]) {
+    CommandLine options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            options.has_seed = true;
+            options.seed = static_cast<std::uint32_t>(
+                ParseNumber(argv[++i], "--seed", 0, std::numeric_limits<std::uint32_t>::max()));
+        } else if (arg == "--trace" && i + 1 < argc) {
+            options.trace_path = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            options.record_prefix = argv[++i];
+        } else if (arg == "--grid" && i + 2 < argc) {
+            options.grid_width = ParseNumber(argv[++i], "--grid", 2, std::numeric_limits<int>::max());
+            options.grid_height = ParseNumber(argv[++i], "--grid", 2, std::numeric_limits<int>::max());
+            // Cells are indexed with int
+            if (options.grid_width * options.grid_height > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+                throw std::invalid_argument("grid too large");
+            }
+        } else if (arg == "--screen" && i + 2 < argc) {
+            options.screen_width = std::max<std::size_t>(ParseNumber(argv[++i], "--screen", 0, kMaxScreenSide), 160);
+            options.screen_height = std::max<std::size_t>(ParseNumber(argv[++i], "--screen", 0, kMaxScreenSide), 160);
+        } else if (arg == "--cell" && i + 1 < argc) {
+            options.cell_size = ParseNumber(argv[++i], "--cell", 0, kMaxCellSize);
+        } else if (arg == "--keep-layout") {
+            options.keep_layout = true;
+        } else {
+            std::cerr << "Unknown option: " << arg << "\n";
+            PrintUsage();
+        }
     }
+    return options;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    CommandLine options;
+    try {
+        options = ParseCommandLine(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        PrintUsage();
+        return 1;
+    }
+    std::uint32_t seed = options.has_seed ? options.seed : std::random_device{}();
+
     constexpr std::size_t kFramesPerSecond{60};
     constexpr std::size_t kMsPerFrame{1000 / kFramesPerSecond};
-    constexpr std::size_t kScreenWidth{640};
-    constexpr std::size_t kScreenHeight{640};
-    constexpr std::size_t kGridWidth{32};
-    constexpr std::size_t kGridHeight{32};
+    const std::size_t screenWidth{options.screen_width};
+    const std::size_t screenHeight{options.screen_height};
+    const std::size_t gridWidth{options.grid_width};
+    const std::size_t gridHeight{options.grid_height};
 
     // 1. Ask for player name
     std::string playerName = AskPlayerName();
@@ -84,30 +173,54 @@ int main() {
 
     // 3. Ask for difficulty and get number of obstacles
     Difficulty difficulty = AskDifficulty();
-    int numObstacles = GetNumObstaclesForDifficulty(difficulty);
+    int numObstacles = GetNumObstaclesForDifficulty(difficulty, gridWidth * gridHeight);
+
+    // 3b. Human or bot; bot runs are ranked under a tagged name
+    bool autopilot = AskAutopilot();
+    std::string rankedName = autopilot ? playerName + " [bot]" : playerName;
 
     // 4. ScoreManager
-    ScoreManager scoreManager("highscores.txt");
+    ScoreManager scoreManager("highscores");
 
     // 5. Create static game objects (renderer/controller)
-    Renderer renderer(kScreenWidth, kScreenHeight, kGridWidth, kGridHeight);
+    Renderer renderer(screenWidth, screenHeight, gridWidth, gridHeight, options.cell_size);
     Controller controller;
+    FrameProfiler simProfiler("game loop");        // game thread: input, update, wait
+    FrameProfiler renderProfiler("render frame");  // render thread: snapshot, render, present, sleep
+
+    // 6. One Game for the whole session, allocated from a RoundArena; each
+    //    new round resets it in place and reuses all of its buffers
+    RoundArena roundArena;
+    Game game(gridWidth, gridHeight, playerName, initialSpeed, numObstacles, seed, autopilot,
+              roundArena.Resource());
+    const ObstacleLayout layout = options.keep_layout ? ObstacleLayout::Keep : ObstacleLayout::Regenerate;
 
     bool running = true;
+    bool firstRound = true;
     while (running) {
-        // 6. Create a new Game each round
-        Game game(kGridWidth, kGridHeight, playerName, initialSpeed, numObstacles);
+        if (!firstRound) game.Reset(seed, layout);
+        firstRound = false;
+        std::cout << "Round seed: " << game.GetSeed() << std::endl;
+        seed++;
 
         // 7. Run the game
-        game.Run(controller, renderer, kMsPerFrame);
-
-        // 8. Save the final score
+        game.Run(controller, renderer, kMsPerFrame, simProfiler, renderProfiler);
+
+        // 8. Save the replay and the final score
+        if (!options.record_prefix.empty()) {
+            std::string path = options.record_prefix + "-" + std::to_string(game.GetSeed()) + ".replay";
+            if (SaveReplay(path, game.GetReplay())) {
+                std::cout << "Replay saved to " << path << std::endl;
+            } else {
+                std::cerr << "Could not save replay to " << path << std::endl;
+            }
+        }
         int final_score = game.GetScore();
-        scoreManager.AddScore(playerName, final_score);
+        scoreManager.AddScore(rankedName, final_score);
 
-        // 9. Save scores asynchronously and wait for completion (optional)
-        auto fut = scoreManager.SaveScoresAsync();
-        fut.wait();
+        // 9. Queue the save; the writer thread does the disk I/O and
+        //    ~ScoreManager flushes anything still pending on exit
+        scoreManager.SaveScoresAsync();
 
         // 10. Show ranking
         auto topScores = scoreManager.GetHighScores();
@@ -117,14 +230,25 @@ int main() {
         }
 
         // 11. Visual "GAME OVER" message + instructions
-        renderer.RenderGameOverMessageWithInstructions();
+        renderer.ShowGameOverInstructions();
 
         // 12. Wait for user input: R = restart, Q = quit
         char action = renderer.WaitRestartOrQuit();
         if (action == 'q') {
             running = false;
         }
-        // If 'r', loop restarts and a new game is created with the same settings
+        // If 'r', the loop restarts and the game is reset with the next seed
+    }
+
+    // 13. Per-thread time percentiles and optional Chrome trace
+    simProfiler.PrintSummary(std::cout);
+    renderProfiler.PrintSummary(std::cout);
+    if (!options.trace_path.empty()) {
+        if (FrameProfiler::WriteChromeTrace(options.trace_path, {&simProfiler, &renderProfiler})) {
+            std::cout << "Trace written to " << options.trace_path << std::endl;
+        } else {
+            std::cerr << "Could not write trace to " << options.trace_path << std::endl;
+        }
     }
     return 0;
 }
@@ -0,0 +1,94 @@
+#include "occupancy_grid.h"
+#include <algorithm>
+
+OccupancyGrid::OccupancyGrid(int width, int height, std::pmr::memory_resource *resource)
+    : width_(width),
+      height_(height),
+      cells_(static_cast<std::size_t>(width) * height, 0, resource),
+      free_cells_(cells_.size(), resource),
+      free_slot_(cells_.size(), resource),
+      chunks_x_((width + kChunkSize - 1) >> kChunkShift),
+      chunks_y_((height + kChunkSize - 1) >> kChunkShift),
+      chunk_counts_(static_cast<std::size_t>(chunks_x_) * chunks_y_ * kNumFlags, 0, resource),
+      changed_(resource),
+      changed_mark_(resource) {
+  for (int i = 0; i < static_cast<int>(cells_.size()); ++i) {
+    free_cells_[i] = i;
+    free_slot_[i] = i;
+  }
+}
+
+void OccupancyGrid::Reset() {
+  std::fill(cells_.begin(), cells_.end(), 0);
+  free_cells_.resize(cells_.size());
+  for (int i = 0; i < static_cast<int>(cells_.size()); ++i) {
+    free_cells_[i] = i;
+    free_slot_[i] = i;
+  }
+  std::fill(chunk_counts_.begin(), chunk_counts_.end(), 0);
+  changed_.clear();
+  std::fill(changed_mark_.begin(), changed_mark_.end(), 0);
+}
+
+void OccupancyGrid::Set(int x, int y, std::uint8_t flags) {
+  int index = Index(x, y);
+  if (cells_[index] == 0 && flags != 0) MarkUsed(index);
+  std::uint8_t added = flags & ~cells_[index];
+  if (added == 0) return;
+  CountChunk(x, y, added, +1);
+  cells_[index] |= flags;
+  MarkChanged(index);
+}
+
+void OccupancyGrid::Clear(int x, int y, std::uint8_t flags) {
+  int index = Index(x, y);
+  if (cells_[index] == 0) return;
+  std::uint8_t removed = flags & cells_[index];
+  if (removed == 0) return;
+  CountChunk(x, y, removed, -1);
+  cells_[index] &= static_cast<std::uint8_t>(~flags);
+  MarkChanged(index);
+  if (cells_[index] == 0) MarkFree(index);
+}
+
+void OccupancyGrid::MarkUsed(int index) {
+  // Swap-remove: a última célula livre ocupa o lugar da removida.
+  int slot = free_slot_[index];
+  int last = free_cells_.back();
+  free_cells_[slot] = last;
+  free_slot_[last] = slot;
+  free_cells_.pop_back();
+  free_slot_[index] = -1;
+}
+
+void OccupancyGrid::MarkFree(int index) {
+  free_slot_[index] = static_cast<int>(free_cells_.size());
+  free_cells_.push_back(index);
+}
+
+void OccupancyGrid::CountChunk(int x, int y, std::uint8_t flags, int delta) {
+  if (flags == 0) return;
+  std::size_t base = (static_cast<std::size_t>(y >> kChunkShift) * chunks_x_ + (x >> kChunkShift)) * kNumFlags;
+  for (int bit = 0; bit < kNumFlags; ++bit) {
+    if (flags & (1 << bit)) chunk_counts_[base + bit] = static_cast<std::uint16_t>(chunk_counts_[base + bit] + delta);
+  }
+}
+
+bool OccupancyGrid::ChunkHas(int cx, int cy, std::uint8_t flags) const {
+  std::size_t base = (static_cast<std::size_t>(cy) * chunks_x_ + cx) * kNumFlags;
+  for (int bit = 0; bit < kNumFlags; ++bit) {
+    if ((flags & (1 << bit)) && chunk_counts_[base + bit] != 0) return true;
+  }
+  return false;
+}
+
+void OccupancyGrid::TrackChanges(bool enabled) {
+  tracking_ = enabled;
+  ClearChanges();
+  changed_mark_.assign(enabled ? cells_.size() : 0, 0);
+}
+
+void OccupancyGrid::ClearChanges() {
+  for (int index : changed_) changed_mark_[index] = 0;
+  changed_.clear();
+}
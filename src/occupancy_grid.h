@@ -0,0 +1,97 @@
+#ifndef OCCUPANCY_GRID_H
+#define OCCUPANCY_GRID_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+// Grade de ocupação compartilhada: um byte de flags por célula.
+// Snake, Game e os obstáculos mantêm as flags atualizadas de forma
+// incremental, então toda consulta de ocupação/colisão é O(1).
+// Também mantém o conjunto de células livres (array com swap-remove +
+// índice de posição), para sortear uma célula livre em O(1), e quantas
+// células de cada flag há em cada bloco de 16x16, para o renderer pular
+// blocos vazios.
+class OccupancyGrid {
+ public:
+  enum Flag : std::uint8_t {
+    kSnake = 1 << 0,
+    kObstacle = 1 << 1,
+    kFood = 1 << 2,
+  };
+  static constexpr int kNumFlags = 3;
+
+  static constexpr int kChunkShift = 4;
+  static constexpr int kChunkSize = 1 << kChunkShift;
+
+  // Toda a memória da grade vem de resource (por padrão, o heap)
+  OccupancyGrid(int width, int height,
+                std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  int Width() const { return width_; }
+  int Height() const { return height_; }
+
+  std::uint8_t At(int x, int y) const { return cells_[Index(x, y)]; }
+  bool Has(int x, int y, std::uint8_t flags) const { return (At(x, y) & flags) != 0; }
+  bool IsFree(int x, int y) const { return At(x, y) == 0; }
+
+  void Set(int x, int y, std::uint8_t flags);
+  void Clear(int x, int y, std::uint8_t flags);
+  // Volta ao estado de recém-construída (inclusive a ordem das livres),
+  // sem realocar. O registro de mudanças é esvaziado: quem copia a grade
+  // por delta precisa de uma cópia inteira depois.
+  void Reset();
+  // Troca todas as flags da célula por `flags` (para cópias da grade)
+  void Replace(int x, int y, std::uint8_t flags) {
+    Clear(x, y, static_cast<std::uint8_t>(At(x, y) & ~flags));
+    Set(x, y, flags);
+  }
+
+  // Um byte de flags por célula, linha a linha
+  const std::pmr::vector<std::uint8_t> &Cells() const { return cells_; }
+
+  // Células livres: i em [0, FreeCount()). A ordem muda a cada Set/Clear.
+  int FreeCount() const { return static_cast<int>(free_cells_.size()); }
+  void FreeCell(int i, int &x, int &y) const {
+    x = free_cells_[i] % width_;
+    y = free_cells_[i] / width_;
+  }
+
+  // Registro das células cujas flags mudaram desde o último ClearChanges,
+  // feito no próprio Set/Clear (sem comparar quadros). Desligado por padrão.
+  void TrackChanges(bool enabled);
+  const std::pmr::vector<int> &ChangedCells() const { return changed_; }
+  void ClearChanges();
+
+  // Blocos de kChunkSize x kChunkSize células (os da borda podem ser menores).
+  int ChunksX() const { return chunks_x_; }
+  int ChunksY() const { return chunks_y_; }
+  // true se o bloco (cx, cy) tem alguma célula com uma das flags
+  bool ChunkHas(int cx, int cy, std::uint8_t flags) const;
+
+ private:
+  int Index(int x, int y) const { return y * width_ + x; }
+  void MarkUsed(int index);
+  void MarkFree(int index);
+  void CountChunk(int x, int y, std::uint8_t flags, int delta);
+  void MarkChanged(int index) {
+    if (tracking_ && !changed_mark_[index]) {
+      changed_mark_[index] = 1;
+      changed_.push_back(index);
+    }
+  }
+
+  int width_;
+  int height_;
+  std::pmr::vector<std::uint8_t> cells_;
+  std::pmr::vector<int> free_cells_;
+  std::pmr::vector<int> free_slot_;  // posição de cada célula em free_cells_, -1 se ocupada
+  int chunks_x_;
+  int chunks_y_;
+  std::pmr::vector<std::uint16_t> chunk_counts_;  // kNumFlags contadores por bloco
+  bool tracking_{false};
+  std::pmr::vector<int> changed_;               // índices, sem repetição
+  std::pmr::vector<std::uint8_t> changed_mark_; // 1 se já está em changed_
+};
+
+#endif  // OCCUPANCY_GRID_H
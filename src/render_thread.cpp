@@ -0,0 +1,89 @@
+#include "render_thread.h"
+#include <algorithm>
+#include <chrono>
+
+RenderThread::RenderThread(Renderer &renderer, SnapshotBuffer &snapshots, FrameProfiler &profiler,
+                           int grid_width, int grid_height, std::size_t target_frame_duration)
+    : renderer_(renderer),
+      snapshots_(snapshots),
+      profiler_(profiler),
+      grid_(grid_width, grid_height),
+      target_frame_duration_(target_frame_duration) {
+  grid_.TrackChanges(true);
+  thread_ = std::thread(&RenderThread::Loop, this);
+}
+
+RenderThread::~RenderThread() { Stop(); }
+
+void RenderThread::Stop() {
+  stop_.store(true, std::memory_order_relaxed);
+  if (thread_.joinable()) thread_.join();
+}
+
+void RenderThread::TakeStats(int &frames, float &frame_ms, int &draw_calls) {
+  frames = frames_.exchange(0, std::memory_order_relaxed);
+  std::int64_t work_ns = work_ns_.exchange(0, std::memory_order_relaxed);
+  frame_ms = frames > 0 ? static_cast<float>(work_ns) / 1e6f / frames : 0.0f;
+  draw_calls = draw_calls_.load(std::memory_order_relaxed);
+}
+
+void RenderThread::Loop() {
+  using Phase = FrameProfiler::Phase;
+  using Clock = std::chrono::steady_clock;
+  const Clock::duration tick = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / Simulation::kTicksPerSecond));
+  const Clock::duration frame_budget = std::chrono::milliseconds(target_frame_duration_);
+
+  renderer_.CreateContext();
+  const FrameSnapshot *frame = nullptr;
+  bool still_drawn = false;  // pausa/fim de jogo já na tela
+
+  while (!stop_.load(std::memory_order_relaxed)) {
+    Clock::time_point frame_start = Clock::now();
+    const FrameSnapshot *latest = snapshots_.Acquire();
+    if (latest == nullptr && (frame == nullptr || still_drawn)) {
+      // Nada novo para mostrar: não redesenha a imagem parada
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      continue;
+    }
+
+    profiler_.BeginFrame();
+    if (latest != nullptr) {
+      // Sem base comum a grade veio inteira: repinta tudo
+      if (ApplySnapshot(*latest, grid_)) renderer_.ResetBoard();
+      frame = latest;
+      still_drawn = false;
+    }
+    profiler_.Mark(Phase::kSnapshot);
+
+    // Fração do tick seguinte já decorrida desde que este foi simulado
+    bool still = frame->paused || frame->over;
+    float alpha = 1.0f;
+    if (!still) {
+      alpha = std::chrono::duration<float>(frame_start - frame->tick_time) / std::chrono::duration<float>(tick);
+      alpha = std::min(std::max(alpha, 0.0f), 1.0f);
+    }
+    renderer_.Render(*frame, grid_, alpha);
+    grid_.ClearChanges();
+    if (frame->over) {
+      renderer_.RenderGameOverOverlay();
+    } else if (frame->paused) {
+      renderer_.RenderPauseOverlay();
+    }
+    profiler_.Mark(Phase::kRender);
+    renderer_.Present();
+    profiler_.Mark(Phase::kPresent);
+    still_drawn = still;
+
+    frames_.fetch_add(1, std::memory_order_relaxed);
+    work_ns_.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - frame_start).count(),
+                       std::memory_order_relaxed);
+    draw_calls_.store(renderer_.DrawCalls(), std::memory_order_relaxed);
+
+    // Espera o resto do quadro com relógio de alta resolução
+    if (!still) std::this_thread::sleep_until(frame_start + frame_budget);
+    profiler_.Mark(Phase::kSleep);
+    profiler_.EndFrame();
+  }
+  renderer_.DestroyContext();
+}
@@ -0,0 +1,50 @@
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include "frame_profiler.h"
+#include "frame_snapshot.h"
+#include "occupancy_grid.h"
+#include "renderer.h"
+
+// Thread que desenha: cria o contexto do Renderer, pega sempre o snapshot
+// mais novo do SnapshotBuffer, aplica o delta na sua cópia da grade e
+// apresenta. Um present lento (vsync, GPU) atrasa só esta thread; a
+// simulação e o input seguem no ritmo deles na thread principal.
+class RenderThread {
+ public:
+  RenderThread(Renderer &renderer, SnapshotBuffer &snapshots, FrameProfiler &profiler,
+               int grid_width, int grid_height, std::size_t target_frame_duration);
+  ~RenderThread();  // Stop()
+
+  RenderThread(const RenderThread&) = delete;
+  RenderThread& operator=(const RenderThread&) = delete;
+
+  // Termina o quadro atual, libera o contexto e espera a thread.
+  void Stop();
+
+  // Estatísticas para o título da janela, lidas pela thread principal:
+  // quadros e tempo de trabalho (sem o sleep) desde a última chamada, e
+  // chamadas de desenho do último quadro.
+  void TakeStats(int &frames, float &frame_ms, int &draw_calls);
+
+ private:
+  void Loop();
+
+  Renderer &renderer_;
+  SnapshotBuffer &snapshots_;
+  FrameProfiler &profiler_;
+  OccupancyGrid grid_;  // só desta thread
+  std::size_t target_frame_duration_;
+
+  std::atomic<bool> stop_{false};
+  std::atomic<int> frames_{0};
+  std::atomic<std::int64_t> work_ns_{0};
+  std::atomic<int> draw_calls_{0};
+  std::thread thread_;
+};
+
+#endif  // RENDER_THREAD_H
@@ -1,92 +1,35 @@
 #include "renderer.h"
-#include "game.h"    // Para ter acesso a struct Food e enum FoodType
+#include "font5x7.h"
+#include "simulation.h"    // Para ter acesso a struct Food e enum FoodType
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
 #include <string>
 
-// Letras G, A, M, E (espaço), O, V, E, R
-const int letter_height = 7, letter_width = 7;
-const int spacing = 2; // Espaço entre letras
-
-// Letras, 1 = bloco, 0 = vazio
-const int letters[8][7][7] = {
-  // G
-  {{1,1,1,1,1,1,0},
-   {1,0,0,0,0,0,0},
-   {1,0,0,0,0,0,0},
-   {1,0,0,1,1,1,0},
-   {1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0},
-   {1,1,1,1,1,1,0}},
-  // A
-  {{0,1,1,1,1,0,0},
-   {1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0},
-   {1,1,1,1,1,1,0},
-   {1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0}},
-  // M
-  {{1,0,0,0,0,0,1},
-   {1,1,0,0,0,1,1},
-   {1,0,1,0,1,0,1},
-   {1,0,0,1,0,0,1},
-   {1,0,0,0,0,0,1},
-   {1,0,0,0,0,0,1},
-   {1,0,0,0,0,0,1}},
-  // E
-  {{1,1,1,1,1,1,0},
-   {1,0,0,0,0,0,0},
-   {1,0,0,0,0,0,0},
-   {1,1,1,1,1,0,0},
-   {1,0,0,0,0,0,0},
-   {1,0,0,0,0,0,0},
-   {1,1,1,1,1,1,0}},
-  // O
-  {{0,1,1,1,1,0,0},
-   {1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0},
-   {0,1,1,1,1,0,0}},
-  // V
-  {{1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0},
-   {0,1,0,0,1,0,0},
-   {0,0,1,1,0,0,0}},
-  // E (de novo)
-  {{1,1,1,1,1,1,0},
-   {1,0,0,0,0,0,0},
-   {1,0,0,0,0,0,0},
-   {1,1,1,1,1,0,0},
-   {1,0,0,0,0,0,0},
-   {1,0,0,0,0,0,0},
-   {1,1,1,1,1,1,0}},
-  // R
-  {{1,1,1,1,1,0,0},
-   {1,0,0,0,0,1,0},
-   {1,0,0,0,0,1,0},
-   {1,1,1,1,1,0,0},
-   {1,0,1,0,0,0,0},
-   {1,0,0,1,0,0,0},
-   {1,0,0,0,1,0,0}}
-};
-
 Renderer::Renderer(const std::size_t screen_width,
                    const std::size_t screen_height,
-                   const std::size_t grid_width, const std::size_t grid_height)
-    : screen_width(screen_width),
+                   const std::size_t grid_width, const std::size_t grid_height,
+                   const std::size_t cell_size, bool offscreen)
+    : offscreen(offscreen),
+      screen_width(screen_width),
       screen_height(screen_height),
       grid_width(grid_width),
       grid_height(grid_height) {
-  // Initialize SDL
-  if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+  // Tamanho da célula: o pedido, ou o que faz a grade caber na tela
+  int fit = static_cast<int>(std::min(screen_width / grid_width, screen_height / grid_height));
+  this->cell_size = cell_size > 0 ? static_cast<int>(cell_size) : std::max(fit, kMinFitCellSize);
+  camera = grid_width * this->cell_size > screen_width || grid_height * this->cell_size > screen_height;
+  view_cols = camera ? static_cast<int>(screen_width) / this->cell_size + 2 : static_cast<int>(grid_width);
+  view_rows = camera ? static_cast<int>(screen_height) / this->cell_size + 2 : static_cast<int>(grid_height);
+
+  // Initialize SDL (o renderer de software não precisa do vídeo)
+  if (SDL_Init(offscreen ? 0 : SDL_INIT_VIDEO) < 0) {
     std::cerr << "SDL could not initialize.\n";
     std::cerr << "SDL_Error: " << SDL_GetError() << "\n";
   }
+  if (offscreen) return;
 
   // Create Window
   sdl_window = SDL_CreateWindow("Snake Game", SDL_WINDOWPOS_CENTERED,
@@ -97,39 +40,143 @@ Renderer::Renderer(const std::size_t screen_width,
     std::cerr << "Window could not be created.\n";
     std::cerr << " SDL_Error: " << SDL_GetError() << "\n";
   }
+}
+
+Renderer::~Renderer() {
+  DestroyContext();
+  if (sdl_window != nullptr) SDL_DestroyWindow(sdl_window);
+  SDL_Quit();
+}
 
+void Renderer::CreateContext() {
   // Create renderer
-  sdl_renderer = SDL_CreateRenderer(sdl_window, -1, SDL_RENDERER_ACCELERATED);
+  if (offscreen) {
+    surface = SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(screen_width), static_cast<int>(screen_height),
+                                             32, SDL_PIXELFORMAT_RGBA8888);
+    sdl_renderer = surface != nullptr ? SDL_CreateSoftwareRenderer(surface) : nullptr;
+  } else {
+    sdl_renderer = SDL_CreateRenderer(sdl_window, -1, SDL_RENDERER_ACCELERATED);
+  }
   if (nullptr == sdl_renderer) {
     std::cerr << "Renderer could not be created.\n";
     std::cerr << "SDL_Error: " << SDL_GetError() << "\n";
   }
+
+  BuildGlyphAtlas();
+  board_valid = false;
+  board_failed = false;
 }
 
-Renderer::~Renderer() {
-  SDL_DestroyWindow(sdl_window);
-  SDL_Quit();
+void Renderer::DestroyContext() {
+  // Texturas pertencem ao SDL_Renderer: saem antes dele
+  for (SDL_Texture **texture : {&board_layer, &glyph_atlas, &pause_overlay, &game_over_overlay}) {
+    if (*texture != nullptr) SDL_DestroyTexture(*texture);
+    *texture = nullptr;
+  }
+  if (sdl_renderer != nullptr) SDL_DestroyRenderer(sdl_renderer);
+  sdl_renderer = nullptr;
+  if (surface != nullptr) SDL_FreeSurface(surface);
+  surface = nullptr;
 }
 
-void Renderer::Render(Snake const &snake, Food const &food, const std::vector<SDL_Point> &obstacles) {
-    SDL_Rect block;
-    block.w = screen_width / grid_width;
-    block.h = screen_height / grid_height;
+// Interpola entre dois valores de uma coordenada que dá a volta no grid.
+static float InterpolateWrapped(float prev, float current, float alpha, float size) {
+    float delta = current - prev;
+    if (delta > size / 2) delta -= size;
+    if (delta < -size / 2) delta += size;
+    float value = prev + delta * alpha;
+    if (value < 0) value += size;
+    if (value >= size) value -= size;
+    return value;
+}
+
+bool Renderer::UpdateBoard(const FrameSnapshot &frame, const OccupancyGrid &grid) {
+    // Com câmera a tela rola a cada quadro: não há o que reaproveitar
+    if (camera || board_failed) return false;
+    if (board_layer == nullptr) {
+        board_layer = SDL_CreateTexture(sdl_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                        static_cast<int>(screen_width), static_cast<int>(screen_height));
+        if (board_layer == nullptr) {
+            // Sem suporte a render target: Render desenha tudo a cada quadro
+            std::cerr << "Board texture could not be created.\n";
+            std::cerr << "SDL_Error: " << SDL_GetError() << "\n";
+            board_failed = true;
+            return false;
+        }
+        board_valid = false;
+    }
+    SDL_SetRenderTarget(sdl_renderer, board_layer);
+    if (board_valid) {
+        RepaintChangedCells(grid, frame);
+    } else {
+        // Primeira imagem da rodada: tudo, sem a célula da cabeça, igual ao
+        // desenho completo (a cabeça interpolada é desenhada por cima)
+        DrawBackground(grid);
+        DrawFood(frame.food);
+        rects.clear();
+        CollectVisibleCells(grid, OccupancyGrid::kSnake, frame.head_cell_x, frame.head_cell_y);
+        SDL_SetRenderDrawColor(sdl_renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+        FillRects();
+        board_valid = true;
+    }
+    board_head_x = frame.head_cell_x;
+    board_head_y = frame.head_cell_y;
+    SDL_SetRenderTarget(sdl_renderer, nullptr);
+    return true;
+}
+
+void Renderer::RepaintChangedCells(const OccupancyGrid &grid, const FrameSnapshot &frame) {
+    // Cada célula do delta é repintada com o que tem agora; uma chamada
+    // por cor, então o custo acompanha o número de células alteradas
+    enum { kBackground, kObstacle, kFood, kSnake };
+    for (std::vector<SDL_Rect> &list : changed_rects) list.clear();
+    // A célula da cabeça não tem cobra na camada (a cabeça interpolada vai
+    // por cima); a que deixou de ser cabeça volta a ser pintada pela grade
+    auto repaint = [&](int x, int y) {
+        bool head = x == frame.head_cell_x && y == frame.head_cell_y;
+        int kind = grid.Has(x, y, OccupancyGrid::kObstacle)          ? kObstacle
+                   : !head && grid.Has(x, y, OccupancyGrid::kSnake) ? kSnake
+                   : grid.Has(x, y, OccupancyGrid::kFood)            ? kFood
+                                                                     : kBackground;
+        changed_rects[kind].push_back({x * cell_size, y * cell_size, cell_size, cell_size});
+    };
+    const int width = grid.Width();
+    for (int index : grid.ChangedCells()) repaint(index % width, index / width);
+    if (board_head_x != frame.head_cell_x || board_head_y != frame.head_cell_y) {
+        if (board_head_x >= 0) repaint(board_head_x, board_head_y);
+        repaint(frame.head_cell_x, frame.head_cell_y);
+    }
+    const FoodType food_type = frame.food.type;
+
+    static const Uint8 kColors[4][3] = {{0x1E, 0x1E, 0x1E}, {80, 80, 80}, {0, 0, 0}, {0xFF, 0xFF, 0xFF}};
+    for (int kind = 0; kind < 4; ++kind) {
+        const std::vector<SDL_Rect> &list = changed_rects[kind];
+        if (list.empty()) continue;
+        if (kind == kFood) {
+            SetFoodColor(food_type);
+        } else {
+            SDL_SetRenderDrawColor(sdl_renderer, kColors[kind][0], kColors[kind][1], kColors[kind][2], 0xFF);
+        }
+        SDL_RenderFillRects(sdl_renderer, list.data(), static_cast<int>(list.size()));
+        draw_calls++;
+    }
+}
 
+void Renderer::DrawBackground(const OccupancyGrid &grid) {
     // Clear screen (background)
     SDL_SetRenderDrawColor(sdl_renderer, 0x1E, 0x1E, 0x1E, 0xFF);
     SDL_RenderClear(sdl_renderer);
+    draw_calls++;
 
-    // Draw obstacles
+    // Draw visible obstacles in one batch
+    rects.clear();
+    CollectVisibleCells(grid, OccupancyGrid::kObstacle, -1, -1);
     SDL_SetRenderDrawColor(sdl_renderer, 80, 80, 80, 255); // Grey
-    for (auto const &block_point : obstacles) {
-        block.x = block_point.x * block.w;
-        block.y = block_point.y * block.h;
-        SDL_RenderFillRect(sdl_renderer, &block);
-    }
+    FillRects();
+}
 
-    // Render food (color by type)
-    switch (food.type) {
+void Renderer::SetFoodColor(FoodType type) {
+    switch (type) {
         case FoodType::Normal:
             SDL_SetRenderDrawColor(sdl_renderer, 0xFF, 0xCC, 0x00, 0xFF); // Yellow
             break;
@@ -143,69 +190,239 @@ void Renderer::Render(Snake const &snake, Food const &food, const std::vector<SD
             SDL_SetRenderDrawColor(sdl_renderer, 0xFF, 0xFF, 0xFF, 0xFF); // White
             break;
     }
-    block.x = food.pos.x * block.w;
-    block.y = food.pos.y * block.h;
+}
+
+void Renderer::DrawFood(const Food &food) {
+    SDL_Rect block;
+    if (food.pos.x < 0 || !ToScreen(static_cast<float>(food.pos.x), static_cast<float>(food.pos.y), block)) return;
+    SetFoodColor(food.type);
     SDL_RenderFillRect(sdl_renderer, &block);
+    draw_calls++;
+}
 
-    // Render snake's body
-    SDL_SetRenderDrawColor(sdl_renderer, 0xFF, 0xFF, 0xFF, 0xFF);
-    for (SDL_Point const &point : snake.body) {
-        block.x = point.x * block.w;
-        block.y = point.y * block.h;
-        SDL_RenderFillRect(sdl_renderer, &block);
+void Renderer::FillRects() {
+    if (rects.empty()) return;
+    SDL_RenderFillRects(sdl_renderer, rects.data(), static_cast<int>(rects.size()));
+    draw_calls++;
+}
+
+// Coordenada em [0, size), para posições que deram a volta no grid
+static float WrapCoord(float value, float size) {
+    value = std::fmod(value, size);
+    return value < 0 ? value + size : value;
+}
+
+void Renderer::UpdateCamera(float x, float y) {
+    if (!camera) {
+        camera_x = 0;
+        camera_y = 0;
+        return;
     }
+    // Cabeça no centro da tela
+    float half_w = static_cast<float>(screen_width) / (2.0f * cell_size);
+    float half_h = static_cast<float>(screen_height) / (2.0f * cell_size);
+    camera_x = WrapCoord(x + 0.5f - half_w, static_cast<float>(grid_width));
+    camera_y = WrapCoord(y + 0.5f - half_h, static_cast<float>(grid_height));
+}
+
+bool Renderer::ToScreen(float x, float y, SDL_Rect &rect) const {
+    float w = static_cast<float>(grid_width), h = static_cast<float>(grid_height);
+    // Distância da câmera em [-1, tamanho - 1): células parcialmente à esquerda/acima contam
+    float dx = WrapCoord(x - camera_x + 1.0f, w) - 1.0f;
+    float dy = WrapCoord(y - camera_y + 1.0f, h) - 1.0f;
+    rect = {static_cast<int>(std::floor(dx * cell_size)), static_cast<int>(std::floor(dy * cell_size)),
+            cell_size, cell_size};
+    return rect.x < static_cast<int>(screen_width) && rect.y < static_cast<int>(screen_height);
+}
+
+namespace {
+
+// Trecho [begin, end) de células visíveis numa dimensão; offset é a
+// coluna/linha da tela onde ele começa. A janela pode dar a volta no
+// grid, então são no máximo dois trechos.
+struct Span {
+    int begin, end, offset;
+};
+
+int VisibleSpans(int start, int count, int size, Span spans[2]) {
+    int first = std::min(count, size - start);
+    spans[0] = {start, start + first, 0};
+    if (first == count) return 1;
+    spans[1] = {0, count - first, first};
+    return 2;
+}
+
+}  // namespace
+
+void Renderer::CollectVisibleCells(const OccupancyGrid &grid, std::uint8_t flags, int skip_x, int skip_y) {
+    const int shift = OccupancyGrid::kChunkShift;
+    const int x0 = static_cast<int>(camera_x), y0 = static_cast<int>(camera_y);
+    const int frac_x = static_cast<int>((camera_x - x0) * cell_size);
+    const int frac_y = static_cast<int>((camera_y - y0) * cell_size);
+    Span xs[2], ys[2];
+    int nx = VisibleSpans(x0, std::min(view_cols, grid.Width()), grid.Width(), xs);
+    int ny = VisibleSpans(y0, std::min(view_rows, grid.Height()), grid.Height(), ys);
+
+    // Percorre só os blocos visíveis que têm alguma célula com as flags:
+    // o custo acompanha a área na tela, não o tamanho da cobra
+    for (int iy = 0; iy < ny; ++iy) {
+        const Span &sy = ys[iy];
+        for (int cy = sy.begin >> shift; cy <= (sy.end - 1) >> shift; ++cy) {
+            int y_lo = std::max(sy.begin, cy << shift), y_hi = std::min(sy.end, (cy + 1) << shift);
+            for (int ix = 0; ix < nx; ++ix) {
+                const Span &sx = xs[ix];
+                for (int cx = sx.begin >> shift; cx <= (sx.end - 1) >> shift; ++cx) {
+                    if (!grid.ChunkHas(cx, cy, flags)) continue;
+                    int x_lo = std::max(sx.begin, cx << shift), x_hi = std::min(sx.end, (cx + 1) << shift);
+                    for (int y = y_lo; y < y_hi; ++y) {
+                        int py = (y - sy.begin + sy.offset) * cell_size - frac_y;
+                        for (int x = x_lo; x < x_hi; ++x) {
+                            if (!grid.Has(x, y, flags) || (x == skip_x && y == skip_y)) continue;
+                            rects.push_back({(x - sx.begin + sx.offset) * cell_size - frac_x, py,
+                                             cell_size, cell_size});
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void Renderer::Render(const FrameSnapshot &frame, const OccupancyGrid &grid, float alpha) {
+    SDL_Rect block;
+    draw_calls = 0;
+
+    // Cabeça interpolada entre os dois últimos ticks; a câmera a acompanha
+    float head_x = InterpolateWrapped(frame.prev_head_x, frame.head_x, alpha, static_cast<float>(grid_width));
+    float head_y = InterpolateWrapped(frame.prev_head_y, frame.head_y, alpha, static_cast<float>(grid_height));
+    UpdateCamera(head_x, head_y);
+
+    if (UpdateBoard(frame, grid)) {
+        // Tabuleiro já atualizado pelo delta: uma cópia
+        SDL_RenderCopy(sdl_renderer, board_layer, nullptr, nullptr);
+        draw_calls++;
+    } else {
+        DrawBackground(grid);
+
+        // Render food (color by type)
+        DrawFood(frame.food);
+
+        // Render snake's body in one batch, from the grid: only visible cells,
+        // without the head cell (the interpolated head is drawn below)
+        rects.clear();
+        CollectVisibleCells(grid, OccupancyGrid::kSnake, frame.head_cell_x, frame.head_cell_y);
+        SDL_SetRenderDrawColor(sdl_renderer, 0xFF, 0xFF, 0xFF, 0xFF);
+        FillRects();
+    }
+
+    // Comida bônus: fora da grade, desenhada a cada quadro
+    if (frame.bonus_active) DrawFood(frame.bonus_food);
 
     // Render snake's head
-    block.x = static_cast<int>(snake.head_x) * block.w;
-    block.y = static_cast<int>(snake.head_y) * block.h;
-    if (snake.alive) {
+    ToScreen(head_x, head_y, block);
+    if (frame.alive) {
         SDL_SetRenderDrawColor(sdl_renderer, 0x00, 0x7A, 0xCC, 0xFF);
     } else {
         SDL_SetRenderDrawColor(sdl_renderer, 0xFF, 0x00, 0x00, 0xFF);
     }
     SDL_RenderFillRect(sdl_renderer, &block);
+    draw_calls++;
+}
 
+void Renderer::Present() {
     // Update Screen
     SDL_RenderPresent(sdl_renderer);
 }
 
-void Renderer::UpdateWindowTitle(int score, int fps) {
-  std::string title{"Snake Score: " + std::to_string(score) + " FPS: " + std::to_string(fps)};
+void Renderer::UpdateWindowTitle(int score, int fps, int draw_calls, float frame_ms) {
+  char frame[16];
+  std::snprintf(frame, sizeof(frame), "%.2f", frame_ms);
+  std::string title{"Snake Score: " + std::to_string(score) + " FPS: " + std::to_string(fps) +
+                    " Draws: " + std::to_string(draw_calls) + " Frame: " + frame + " ms"};
   SDL_SetWindowTitle(sdl_window, title.c_str());
 }
 
-void Renderer::RenderGameOverMessage() {
-    // Configurações dos blocos
-    int block_size = screen_width / 80; // ajusta conforme seu grid
-    int total_letters = 8;
-    int msg_width = total_letters * (letter_width * block_size + spacing * block_size);
-    int msg_height = letter_height * block_size;
+void Renderer::BuildGlyphAtlas() {
+    // Todos os glifos lado a lado, numa única textura branca com alfa; a cor
+    // é aplicada na cópia com SDL_SetTextureColorMod.
+    const int atlas_w = kFontNumGlyphs * kGlyphCell;
+    const int atlas_h = kFontGlyphHeight;
+    std::vector<Uint32> pixels(static_cast<std::size_t>(atlas_w) * atlas_h, 0);
+    for (int g = 0; g < kFontNumGlyphs; ++g) {
+        for (int col = 0; col < kFontGlyphWidth; ++col) {
+            for (int row = 0; row < kFontGlyphHeight; ++row) {
+                if (kFont5x7[g][col] & (1 << row)) {
+                    pixels[row * atlas_w + g * kGlyphCell + col] = 0xFFFFFFFF;
+                }
+            }
+        }
+    }
+    glyph_atlas = SDL_CreateTexture(sdl_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC,
+                                    atlas_w, atlas_h);
+    if (glyph_atlas == nullptr) {
+        std::cerr << "Glyph atlas could not be created.\n";
+        std::cerr << "SDL_Error: " << SDL_GetError() << "\n";
+        return;
+    }
+    SDL_UpdateTexture(glyph_atlas, nullptr, pixels.data(), atlas_w * static_cast<int>(sizeof(Uint32)));
+    SDL_SetTextureBlendMode(glyph_atlas, SDL_BLENDMODE_BLEND);
+}
+
+int Renderer::TextWidth(const std::string &text, int scale) const {
+    if (text.empty()) return 0;
+    return static_cast<int>(text.size()) * kGlyphCell * scale - scale;
+}
 
-    int base_x = (screen_width - msg_width) / 2;
-    int base_y = (screen_height - msg_height) / 2;
+void Renderer::RenderText(const std::string &text, int x, int y, int scale,
+                          Uint8 r, Uint8 g, Uint8 b) {
+    if (glyph_atlas == nullptr) return;
+    SDL_SetTextureColorMod(glyph_atlas, r, g, b);
+    for (char c : text) {
+        int index = static_cast<unsigned char>(c) - kFontFirstChar;
+        if (index < 0 || index >= kFontNumGlyphs) index = '?' - kFontFirstChar;
+        if (c != ' ') {
+            SDL_Rect src = {index * kGlyphCell, 0, kFontGlyphWidth, kFontGlyphHeight};
+            SDL_Rect dst = {x, y, kFontGlyphWidth * scale, kFontGlyphHeight * scale};
+            SDL_RenderCopy(sdl_renderer, glyph_atlas, &src, &dst);
+        }
+        x += kGlyphCell * scale;
+    }
+}
 
+SDL_Texture *Renderer::BuildOverlay(const std::string &text, int scale, Uint8 dim_alpha) {
+    SDL_Texture *overlay = SDL_CreateTexture(sdl_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                             static_cast<int>(screen_width), static_cast<int>(screen_height));
+    if (overlay == nullptr) return nullptr;
+    SDL_SetTextureBlendMode(overlay, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderTarget(sdl_renderer, overlay);
+
+    // Escurece a tela inteira (translúcido)
+    SDL_SetRenderDrawBlendMode(sdl_renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(sdl_renderer, 0, 0, 0, dim_alpha);
+    SDL_RenderClear(sdl_renderer);
+
+    // Caixa centralizada com o texto
+    int text_w = TextWidth(text, scale);
+    int text_h = kFontGlyphHeight * scale;
+    int base_x = (static_cast<int>(screen_width) - text_w) / 2;
+    int base_y = (static_cast<int>(screen_height) - text_h) / 2;
     SDL_SetRenderDrawColor(sdl_renderer, 50, 50, 50, 220);
-    SDL_Rect background = {base_x - 20, base_y - 20, msg_width + 40, msg_height + 40};
+    SDL_Rect background = {base_x - 20, base_y - 20, text_w + 40, text_h + 40};
     SDL_RenderFillRect(sdl_renderer, &background);
+    RenderText(text, base_x, base_y, scale, 255, 255, 255);
 
-    // Desenha as letras
-    SDL_SetRenderDrawColor(sdl_renderer, 255, 255, 255, 255); // branco
-    for (int l = 0; l < total_letters; ++l) {
-        for (int y = 0; y < letter_height; ++y) {
-            for (int x = 0; x < letter_width; ++x) {
-                if (letters[l][y][x]) {
-                    SDL_Rect block = {
-                        base_x + l * (letter_width * block_size + spacing * block_size) + x * block_size,
-                        base_y + y * block_size,
-                        block_size, block_size
-                    };
-                    SDL_RenderFillRect(sdl_renderer, &block);
-                }
-            }
-        }
+    SDL_SetRenderTarget(sdl_renderer, nullptr);
+    return overlay;
+}
+
+void Renderer::RenderGameOverOverlay() {
+    // Overlay montado uma vez e reaproveitado
+    if (game_over_overlay == nullptr) {
+        game_over_overlay = BuildOverlay("GAME OVER", static_cast<int>(screen_width) / 80, 0);
+    }
+    if (game_over_overlay != nullptr) {
+        SDL_RenderCopy(sdl_renderer, game_over_overlay, nullptr, nullptr);
     }
-    SDL_RenderPresent(sdl_renderer);
-    SDL_Delay(2000); // mostra 2 segundos
 }
 
 char Renderer::WaitRestartOrQuit() {
@@ -225,9 +442,8 @@ char Renderer::WaitRestartOrQuit() {
     }
 }
 
-void Renderer::RenderGameOverMessageWithInstructions() {
-    // Mostra GAME OVER (já faz isso)
-    RenderGameOverMessage();
+void Renderer::ShowGameOverInstructions() {
+    // O GAME OVER já ficou na tela, desenhado pela thread de renderização
     SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_INFORMATION,
                              "Game Over",
                              "Pressione R para reiniciar ou Q para sair.",
@@ -235,30 +451,11 @@ void Renderer::RenderGameOverMessageWithInstructions() {
 }
 
 void Renderer::RenderPauseOverlay() {
-    // Dim background para escurecer
-    SDL_SetRenderDrawBlendMode(sdl_renderer, SDL_BLENDMODE_BLEND);
-    SDL_SetRenderDrawColor(sdl_renderer, 0, 0, 0, 150); // Preto translúcido
-    SDL_Rect full_screen = {0, 0, static_cast<int>(screen_width), static_cast<int>(screen_height)};
-    SDL_RenderFillRect(sdl_renderer, &full_screen);
-
-    // Texto "PAUSED" desenhado no centro usando blocos (similar ao Game Over)
-    const int block_size = screen_width / 40;
-    const char* paused_text = "PAUSED";
-
-    // Para simplificar, desenhe um retângulo branco centralizado com texto desenhado de forma simples:
-    // (Se quiser algo mais elaborado, pode usar SDL_ttf, mas aqui uma caixa simples)
-    SDL_SetRenderDrawColor(sdl_renderer, 255, 255, 255, 255);
-
-    SDL_Rect rect = {
-        static_cast<int>(screen_width / 2) - (block_size * 5),
-        static_cast<int>(screen_height / 2) - (block_size),
-        block_size * 10,
-        block_size * 2
-    };
-    SDL_RenderFillRect(sdl_renderer, &rect);
-
-    // Para desenhar as letras PAUSED usando blocos, você pode definir uma matriz parecida com Game Over,
-    // ou apenas deixar a caixa branca (para teste).
-
-    SDL_RenderPresent(sdl_renderer);
+    // Overlay PAUSED montado uma vez; o Game chama isto só ao entrar na pausa
+    if (pause_overlay == nullptr) {
+        pause_overlay = BuildOverlay("PAUSED", static_cast<int>(screen_width) / 80, 150);
+    }
+    if (pause_overlay != nullptr) {
+        SDL_RenderCopy(sdl_renderer, pause_overlay, nullptr, nullptr);
+    }
 }
@@ -1,43 +1,122 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include <string>
 #include <vector>
 #include "SDL.h"
-#include "snake.h"
-#include "game.h"   // para FoodType, Food
+#include "frame_snapshot.h"
+#include "occupancy_grid.h"
+#include "simulation.h"   // para FoodType, Food
 
 struct Food;
 
 class Renderer {
  public:
+  // cell_size: pixels por célula; 0 ajusta a grade inteira na tela. Se a
+  // grade não couber com pelo menos kMinFitCellSize pixels por célula, a
+  // câmera segue a cabeça e só a parte visível é desenhada.
+  // offscreen: sem janela; desenha com o renderer de software numa
+  // superfície em memória (benchmarks, máquinas sem display).
   Renderer(const std::size_t screen_width, const std::size_t screen_height,
-           const std::size_t grid_width, const std::size_t grid_height);
+           const std::size_t grid_width, const std::size_t grid_height,
+           const std::size_t cell_size = 0, bool offscreen = false);
   ~Renderer();
 
-  void Render(Snake const &snake, Food const &food, const std::vector<SDL_Point> &obstacles);
-  void UpdateWindowTitle(int score, int fps);
+  static constexpr int kMinFitCellSize = 8;
 
-  // Novas funções para Pause e GameOver
+  // O construtor cria só a janela. O SDL_Renderer e as texturas pertencem
+  // à thread que desenha: ela chama CreateContext antes do primeiro Render
+  // e DestroyContext no fim; todo o resto abaixo, exceto
+  // UpdateWindowTitle e ShowGameOverInstructions, roda nessa thread.
+  void CreateContext();
+  void DestroyContext();
+
+  // grid: cópia da grade mantida pela thread de renderização a partir dos
+  // snapshots. alpha: fração do tick atual já decorrida; a cabeça é
+  // interpolada entre a posição do tick anterior e a atual.
+  void Render(const FrameSnapshot &frame, const OccupancyGrid &grid, float alpha = 1.0f);
+  void Present();
+  void UpdateWindowTitle(int score, int fps, int draw_calls, float frame_ms);
+
+  // Sem câmera, o tabuleiro (fundo, obstáculos, comida e corpo) fica numa
+  // textura persistente e cada Render repinta só grid.ChangedCells(); quem
+  // chama limpa o delta depois do Render. ResetBoard força uma repintura
+  // completa no próximo Render (nova rodada, grade recopiada inteira).
+  // Com câmera a tela rola a cada quadro e tudo é redesenhado (recortado).
+  void ResetBoard() { board_valid = false; }
+
+  bool HasCamera() const { return camera; }
+
+  // Chamadas de desenho do último Render (para o título da janela)
+  int DrawCalls() const { return draw_calls; }
+
+  // Texto com o atlas de glifos: um quad texturizado por caractere
+  void RenderText(const std::string &text, int x, int y, int scale,
+                  Uint8 r, Uint8 g, Uint8 b);
+  int TextWidth(const std::string &text, int scale) const;
+
+  // Overlays de Pause e GameOver (em cache), desenhados sobre o quadro
   void RenderPauseOverlay();
-  void RenderGameOverMessage();
-  void RenderGameOverMessageWithInstructions();
+  void RenderGameOverOverlay();
+  // Caixa de mensagem com as teclas de reiniciar/sair (thread principal)
+  void ShowGameOverInstructions();
 
   // Espera input para reiniciar (R) ou sair (Q)
   char WaitRestartOrQuit();
 
  private:
-  SDL_Window *sdl_window;
-  SDL_Renderer *sdl_renderer;
+  void BuildGlyphAtlas();
+  SDL_Texture *BuildOverlay(const std::string &text, int scale, Uint8 dim_alpha);
+  void DrawBackground(const OccupancyGrid &grid);
+  void SetFoodColor(FoodType type);
+  // Atualiza board_layer; false se não há textura (câmera ou sem suporte)
+  bool UpdateBoard(const FrameSnapshot &frame, const OccupancyGrid &grid);
+  // Repinta o delta e a célula da cabeça, que fica fora de board_layer
+  void RepaintChangedCells(const OccupancyGrid &grid, const FrameSnapshot &frame);
+  void DrawFood(const Food &food);
+  void FillRects();  // envia rects numa única SDL_RenderFillRects
+
+  // Centraliza a câmera em (x, y), em células; sem câmera fica em (0, 0).
+  void UpdateCamera(float x, float y);
+  // Acrescenta a rects as células visíveis com alguma das flags, pulando
+  // os blocos do OccupancyGrid sem nenhuma delas e a célula skip_x/skip_y.
+  void CollectVisibleCells(const OccupancyGrid &grid, std::uint8_t flags, int skip_x, int skip_y);
+  // Posição na tela de uma célula (coordenadas fracionárias permitidas)
+  bool ToScreen(float x, float y, SDL_Rect &rect) const;
+
+  SDL_Window *sdl_window{nullptr};
+  SDL_Surface *surface{nullptr};  // alvo do modo offscreen
+  const bool offscreen;
+  SDL_Renderer *sdl_renderer{nullptr};
+  SDL_Texture *board_layer{nullptr};
+  bool board_valid{false};
+  bool board_failed{false};  // render target indisponível: desenha tudo
+  // Célula da cabeça deixada sem cobra em board_layer, como no desenho completo
+  int board_head_x{-1};
+  int board_head_y{-1};
+  SDL_Texture *glyph_atlas{nullptr};
+  SDL_Texture *pause_overlay{nullptr};
+  SDL_Texture *game_over_overlay{nullptr};
+
+  std::vector<SDL_Rect> rects;  // buffer reaproveitado entre quadros
+  // Células do delta separadas por cor: fundo, obstáculo, comida, cobra
+  std::vector<SDL_Rect> changed_rects[4];
+  int draw_calls{0};
 
   const std::size_t screen_width;
   const std::size_t screen_height;
   const std::size_t grid_width;
   const std::size_t grid_height;
 
-  // Definições para renderização de texto (exemplo Game Over)
-  static constexpr int letter_height = 7;
-  static constexpr int letter_width = 7;
-  static constexpr int spacing = 2;
+  int cell_size;  // pixels por célula
+  bool camera;    // grade maior que a tela
+  int view_cols;  // células visíveis (+1 para a célula parcial)
+  int view_rows;
+  float camera_x{0};  // canto superior esquerdo da tela, em células
+  float camera_y{0};
+
+  // Largura de cada glifo no atlas (5 colunas + 1 de espaçamento)
+  static constexpr int kGlyphCell = 6;
 };
 
 #endif
@@ -0,0 +1,174 @@
+#include "replay.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "score_log.h"  // Crc32
+
+namespace {
+
+// Versão 02: movimento em ponto fixo; gravações da 01 (float) não batem mais.
+// Versão 03: layout de obstáculos mantido entre rodadas.
+constexpr char kReplayMagic[8] = {'S', 'N', 'K', 'R', 'P', 'L', '0', '3'};
+
+// Bytes em little-endian, independente da máquina que gravou
+void Put(std::string &out, std::uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+void PutVarint(std::string &out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+class Reader {
+ public:
+    Reader(const std::string &data, std::size_t end) : data_(data), end_(end) {}
+
+    bool Get(std::uint64_t &value, int bytes) {
+        if (pos_ + bytes > end_) return false;
+        value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value |= static_cast<std::uint64_t>(static_cast<unsigned char>(data_[pos_++])) << (8 * i);
+        }
+        return true;
+    }
+
+    bool GetVarint(std::uint64_t &value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && pos_ < end_; shift += 7) {
+            unsigned char byte = static_cast<unsigned char>(data_[pos_++]);
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool AtEnd() const { return pos_ == end_; }
+
+ private:
+    const std::string &data_;
+    std::size_t end_;
+    std::size_t pos_{sizeof(kReplayMagic)};
+};
+
+}  // namespace
+
+void Replay::Record(const Simulation &sim, const SimInput &input) {
+    if (!input.turn) return;
+    events.push_back({sim.State().tick, input.direction});
+}
+
+void Replay::Finish(const Simulation &sim) {
+    final_tick = sim.State().tick;
+    final_score = sim.State().score;
+    final_size = sim.State().size;
+}
+
+bool SaveReplay(const std::string &path, const Replay &replay) {
+    std::string out(kReplayMagic, sizeof(kReplayMagic));
+    std::uint32_t speed_bits;
+    std::memcpy(&speed_bits, &replay.speed, sizeof(speed_bits));
+    Put(out, replay.seed, 4);
+    Put(out, replay.grid_width, 4);
+    Put(out, replay.grid_height, 4);
+    Put(out, speed_bits, 4);
+    Put(out, static_cast<std::uint32_t>(replay.num_obstacles), 4);
+    Put(out, replay.layout_seed, 4);
+    Put(out, replay.keep_layout ? 1u : 0u, 1);
+    Put(out, replay.final_tick, 8);
+    Put(out, static_cast<std::uint32_t>(replay.final_score), 4);
+    Put(out, static_cast<std::uint32_t>(replay.final_size), 4);
+    PutVarint(out, replay.events.size());
+    std::uint64_t last_tick = 0;
+    for (const ReplayEvent &event : replay.events) {
+        PutVarint(out, (event.tick - last_tick) << 2 | static_cast<std::uint64_t>(event.direction));
+        last_tick = event.tick;
+    }
+    Put(out, Crc32(out.data(), out.size()), 4);
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+bool LoadReplay(const std::string &path, Replay &replay) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(kReplayMagic) + 4 ||
+        std::memcmp(data.data(), kReplayMagic, sizeof(kReplayMagic)) != 0) {
+        return false;
+    }
+    std::size_t body_end = data.size() - 4;
+    std::uint64_t stored_crc = 0;
+    for (std::size_t i = 0; i < 4; ++i) {
+        stored_crc |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[body_end + i])) << (8 * i);
+    }
+    if (stored_crc != Crc32(data.data(), body_end)) return false;
+
+    Reader in(data, body_end);
+    Replay result;
+    std::uint64_t seed, width, height, speed_bits, obstacles, layout_seed, keep_layout, final_score, final_size, count;
+    if (!in.Get(seed, 4) || !in.Get(width, 4) || !in.Get(height, 4) || !in.Get(speed_bits, 4) ||
+        !in.Get(obstacles, 4) || !in.Get(layout_seed, 4) || !in.Get(keep_layout, 1) ||
+        !in.Get(result.final_tick, 8) || !in.Get(final_score, 4) ||
+        !in.Get(final_size, 4) || !in.GetVarint(count)) {
+        return false;
+    }
+    // Cabeçalho não confiável: nada fora do que o jogo pode gravar
+    if (width < 2 || height < 2 || width * height > kMaxReplayCells) return false;
+    if (keep_layout > 1 || static_cast<std::int32_t>(obstacles) < 0 || obstacles > width * height) return false;
+    if (result.final_tick > kMaxReplayTicks) return false;
+    result.seed = static_cast<std::uint32_t>(seed);
+    result.grid_width = static_cast<std::uint32_t>(width);
+    result.grid_height = static_cast<std::uint32_t>(height);
+    std::uint32_t bits = static_cast<std::uint32_t>(speed_bits);
+    std::memcpy(&result.speed, &bits, sizeof(bits));
+    // !(x > 0) também pega NaN
+    if (!(result.speed > 0.0f) || !(result.speed <= 1.0f)) return false;
+    result.num_obstacles = static_cast<std::int32_t>(obstacles);
+    result.layout_seed = static_cast<std::uint32_t>(layout_seed);
+    result.keep_layout = keep_layout != 0;
+    result.final_score = static_cast<std::int32_t>(final_score);
+    result.final_size = static_cast<std::int32_t>(final_size);
+
+    std::uint64_t tick = 0;
+    for (std::uint64_t i = 0; i < count; ++i) {
+        std::uint64_t packed;
+        if (!in.GetVarint(packed)) return false;
+        tick += packed >> 2;
+        if (tick > result.final_tick) return false;
+        result.events.push_back({tick, static_cast<Snake::Direction>(packed & 3)});
+    }
+    if (!in.AtEnd()) return false;
+    replay = std::move(result);
+    return true;
+}
+
+ReplayResult PlayReplay(const Replay &replay, std::uint64_t max_ticks) {
+    Simulation sim(replay.grid_width, replay.grid_height, replay.speed, replay.num_obstacles,
+                   replay.keep_layout ? replay.layout_seed : replay.seed);
+    if (replay.keep_layout) sim.Reset(replay.seed, ObstacleLayout::Keep);
+    std::size_t next = 0;
+    const std::uint64_t last_tick = std::min(replay.final_tick, max_ticks);
+    while (!sim.IsOver() && sim.State().tick < last_tick) {
+        SimInput input;
+        // Mais de uma virada no mesmo tick: vale a última, como no jogo
+        while (next < replay.events.size() && replay.events[next].tick == sim.State().tick) {
+            input.turn = true;
+            input.direction = replay.events[next].direction;
+            ++next;
+        }
+        sim.Step(input);
+    }
+    ReplayResult result;
+    result.state = sim.State();
+    result.tick_limit = !sim.IsOver() && result.state.tick < replay.final_tick;
+    result.matches = result.state.tick == replay.final_tick && result.state.score == replay.final_score &&
+                     result.state.size == replay.final_size;
+    return result;
+}
@@ -0,0 +1,69 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "simulation.h"
+
+// Uma mudança de direção aplicada no início do tick `tick`.
+struct ReplayEvent {
+  std::uint64_t tick;
+  Snake::Direction direction;
+};
+
+// Tudo o que é preciso para reproduzir uma partida: a Simulation é
+// determinística, então semente, configurações e as viradas com o tick
+// em que entraram bastam. O resultado final serve para conferência.
+struct Replay {
+  Replay() = default;
+  explicit Replay(std::pmr::memory_resource *resource) : events(resource) {}
+
+  std::uint32_t seed{0};
+  std::uint32_t grid_width{0};
+  std::uint32_t grid_height{0};
+  float speed{0.0f};
+  std::int32_t num_obstacles{0};
+  // Rodada recomeçada com ObstacleLayout::Keep: os obstáculos são os que
+  // layout_seed gerou, e a partida é Simulation(layout_seed) + Reset(seed)
+  bool keep_layout{false};
+  std::uint32_t layout_seed{0};
+  std::pmr::vector<ReplayEvent> events;
+
+  // Resultado gravado
+  std::uint64_t final_tick{0};
+  std::int32_t final_score{0};
+  std::int32_t final_size{0};
+
+  // Registra a entrada que vai ser aplicada no próximo Step.
+  void Record(const Simulation &sim, const SimInput &input);
+  // Copia tick, pontuação e tamanho finais.
+  void Finish(const Simulation &sim);
+};
+
+// Limites de um replay aceito. Arquivos enviados para conferência não são
+// confiáveis: sem eles uma grade enorme derruba o verificador e um tick
+// final absurdo o deixa rodando para sempre.
+constexpr std::uint64_t kMaxReplayTicks = 24ull * 60 * 60 * Simulation::kTicksPerSecond;  // 24 h de jogo
+constexpr std::uint64_t kMaxReplayCells = 4096 * 4096;
+
+// Arquivo: magic "SNKRPL03", cabeçalho fixo, eventos como varints
+// (delta de tick << 2 | direção) e CRC32 no final. LoadReplay recusa
+// cabeçalhos fora dos limites: velocidade fora de (0, 1], lado menor que 2,
+// mais de kMaxReplayCells células ou tick final acima de kMaxReplayTicks.
+bool SaveReplay(const std::string &path, const Replay &replay);
+bool LoadReplay(const std::string &path, Replay &replay);
+
+struct ReplayResult {
+  SimState state;
+  bool matches{false};  // tick, pontuação e tamanho iguais aos gravados
+  bool tick_limit{false};  // parou em max_ticks antes do fim
+};
+
+// Roda a partida sem SDL e sem limite de velocidade até o tick final
+// gravado (ou até o jogo acabar antes, ou até max_ticks) e compara com o
+// resultado gravado.
+ReplayResult PlayReplay(const Replay &replay, std::uint64_t max_ticks = kMaxReplayTicks);
+
+#endif  // REPLAY_H
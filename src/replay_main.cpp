@@ -0,0 +1,111 @@
+// snake_replay: reexecuta replays gravados (SnakeGame --record ou
+// snake_batch --record) pela Simulation, sem SDL e sem limite de
+// velocidade, e confere tick, pontuação e tamanho finais. Serve para
+// reproduzir bugs, validar pontuações enviadas e como corpus de regressão
+// (--max-seconds falha se o conjunto demorar mais que o limite). Cada
+// arquivo roda no máximo --max-ticks ticks, então um replay hostil não
+// trava a conferência.
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "replay.h"
+
+namespace {
+
+struct ReplayOptions {
+    std::vector<std::string> files;
+    double max_seconds = 0;  // 0 = sem limite
+    std::uint64_t max_ticks = kMaxReplayTicks;  // por arquivo
+    bool quiet = false;
+};
+
+void PrintUsage() {
+    std::cout << "Usage: snake_replay [--max-seconds S] [--max-ticks N] [--quiet] FILE...\n";
+}
+
+bool ParseArgs(int argc, char* argv[], ReplayOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--max-seconds") {
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for --max-seconds");
+            options.max_seconds = std::stod(argv[++i]);
+        } else if (arg == "--max-ticks") {
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for --max-ticks");
+            options.max_ticks = std::stoull(argv[++i]);
+        } else if (arg == "--quiet" || arg == "-q") {
+            options.quiet = true;
+        } else if (arg == "--help" || arg == "-h") {
+            return false;
+        } else {
+            options.files.push_back(arg);
+        }
+    }
+    return !options.files.empty();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    ReplayOptions options;
+    try {
+        if (!ParseArgs(argc, argv, options)) {
+            PrintUsage();
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        PrintUsage();
+        return 1;
+    }
+
+    int failures = 0;
+    unsigned long long total_ticks = 0;
+    double total_seconds = 0;
+    for (const std::string& path : options.files) {
+        Replay replay;
+        if (!LoadReplay(path, replay)) {
+            std::cout << path << ": INVALID (unreadable or corrupt replay)\n";
+            ++failures;
+            continue;
+        }
+        auto start = std::chrono::steady_clock::now();
+        ReplayResult result;
+        try {
+            result = PlayReplay(replay, options.max_ticks);
+        } catch (const std::exception& e) {
+            // Ex.: bad_alloc numa grade grande demais para esta máquina
+            std::cout << path << ": FAILED (" << e.what() << ")\n";
+            ++failures;
+            continue;
+        }
+        total_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        total_ticks += result.state.tick;
+
+        if (result.tick_limit) {
+            ++failures;
+            std::cout << path << ": TICK LIMIT  stopped at tick " << result.state.tick << " of "
+                      << replay.final_tick << " (--max-ticks " << options.max_ticks << ")\n";
+        } else if (!result.matches) {
+            ++failures;
+            std::cout << path << ": MISMATCH  recorded score " << replay.final_score << " size "
+                      << replay.final_size << " tick " << replay.final_tick << ", replayed score "
+                      << result.state.score << " size " << result.state.size << " tick "
+                      << result.state.tick << "\n";
+        } else if (!options.quiet) {
+            std::cout << path << ": OK  score " << result.state.score << " size " << result.state.size
+                      << " ticks " << result.state.tick << " seed " << replay.seed << "\n";
+        }
+    }
+
+    std::cout << options.files.size() << " replays, " << failures << " failed, " << total_ticks
+              << " ticks in " << total_seconds << " s ("
+              << (total_seconds > 0 ? total_ticks / total_seconds : 0) << " ticks/s)\n";
+    if (options.max_seconds > 0 && total_seconds > options.max_seconds) {
+        std::cout << "TOO SLOW: limit was " << options.max_seconds << " s\n";
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
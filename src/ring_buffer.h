@@ -0,0 +1,142 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+// Buffer circular com push no fim e pop no início em O(1).
+// A capacidade é sempre potência de dois; reserve() aloca de antemão e o
+// buffer só realoca (dobrando) se passar da capacidade reservada. A
+// memória vem do memory_resource dado (o padrão é o heap); cópias usam o
+// recurso padrão, como os containers std::pmr.
+template <typename T>
+class RingBuffer {
+ public:
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    const_iterator(const RingBuffer *ring, std::size_t pos) : ring_(ring), pos_(pos) {}
+
+    reference operator*() const { return (*ring_)[pos_]; }
+    pointer operator->() const { return &(*ring_)[pos_]; }
+    const_iterator &operator++() { ++pos_; return *this; }
+    const_iterator operator++(int) { const_iterator tmp = *this; ++pos_; return tmp; }
+    bool operator==(const const_iterator &other) const { return pos_ == other.pos_; }
+    bool operator!=(const const_iterator &other) const { return pos_ != other.pos_; }
+
+   private:
+    const RingBuffer *ring_;
+    std::size_t pos_;
+  };
+
+  RingBuffer() = default;
+  explicit RingBuffer(std::size_t capacity) { reserve(capacity); }
+  explicit RingBuffer(std::pmr::memory_resource *resource) : data_(resource) {}
+
+  RingBuffer(const RingBuffer &other) { CopyFrom(other); }
+  RingBuffer &operator=(const RingBuffer &other) {
+    if (this != &other) {
+      clear();
+      CopyFrom(other);
+    }
+    return *this;
+  }
+  RingBuffer(RingBuffer &&other) noexcept
+      : data_(std::move(other.data_)), head_(other.head_), size_(other.size_) {
+    other.data_.clear();
+    other.head_ = 0;
+    other.size_ = 0;
+  }
+  RingBuffer &operator=(RingBuffer &&other) noexcept {
+    if (this == &other) return *this;
+    data_ = std::move(other.data_);
+    head_ = other.head_;
+    size_ = other.size_;
+    other.data_.clear();
+    other.head_ = 0;
+    other.size_ = 0;
+    return *this;
+  }
+
+  void reserve(std::size_t capacity) {
+    if (capacity > data_.size()) Reallocate(RoundUpPow2(capacity));
+  }
+
+  void push_back(const T &value) {
+    if (size_ == data_.size()) Reallocate(data_.empty() ? 16 : data_.size() * 2);
+    data_[(head_ + size_) & Mask()] = value;
+    ++size_;
+  }
+
+  void pop_front() {
+    head_ = (head_ + 1) & Mask();
+    --size_;
+  }
+
+  void clear() {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  const T &operator[](std::size_t i) const { return data_[(head_ + i) & Mask()]; }
+  const T &front() const { return data_[head_]; }
+  const T &back() const { return (*this)[size_ - 1]; }
+
+  // Os elementos em até dois trechos contíguos, na ordem (o segundo é
+  // vazio se o anel não dá a volta). Devolve o tamanho do primeiro.
+  std::size_t Spans(const T *&first, const T *&second, std::size_t &second_size) const {
+    std::size_t first_size = size_;
+    second_size = 0;
+    first = data_.data() + head_;
+    second = data_.data();
+    if (head_ + size_ > data_.size()) {
+      first_size = data_.size() - head_;
+      second_size = size_ - first_size;
+    }
+    return first_size;
+  }
+
+  std::size_t size() const { return size_; }
+  std::size_t capacity() const { return data_.size(); }
+  bool empty() const { return size_ == 0; }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
+
+ private:
+  static std::size_t RoundUpPow2(std::size_t n) {
+    std::size_t cap = 16;
+    while (cap < n) cap <<= 1;
+    return cap;
+  }
+
+  std::size_t Mask() const { return data_.size() - 1; }
+
+  void Reallocate(std::size_t capacity) {
+    std::pmr::vector<T> grown(capacity, data_.get_allocator());
+    for (std::size_t i = 0; i < size_; ++i) grown[i] = (*this)[i];
+    data_ = std::move(grown);
+    head_ = 0;
+  }
+
+  void CopyFrom(const RingBuffer &other) {
+    if (data_.size() < other.data_.size()) data_.assign(other.data_.size(), T{});
+    for (std::size_t i = 0; i < other.size_; ++i) data_[i] = other[i];
+    head_ = 0;
+    size_ = other.size_;
+  }
+
+  std::pmr::vector<T> data_;
+  std::size_t head_{0};
+  std::size_t size_{0};
+};
+
+#endif  // RING_BUFFER_H
@@ -0,0 +1,39 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+#include <random>
+
+// Gerador por jogo, semeado explicitamente. O std::mt19937 tem sequência
+// definida pelo padrão, mas std::uniform_int_distribution não; por isso o
+// sorteio em intervalo é feito aqui, e a mesma semente produz a mesma
+// partida em qualquer compilador/biblioteca.
+class Rng {
+ public:
+  explicit Rng(std::uint32_t seed) : seed_(seed), engine_(seed) {}
+
+  std::uint32_t Seed() const { return seed_; }
+
+  void Reseed(std::uint32_t seed) {
+    seed_ = seed;
+    engine_.seed(seed);
+  }
+
+  std::uint32_t Next() { return static_cast<std::uint32_t>(engine_()); }
+
+  // Inteiro uniforme em [0, n), sem viés (rejeição do resto).
+  std::uint32_t UniformInt(std::uint32_t n) {
+    std::uint32_t threshold = (0u - n) % n;
+    std::uint32_t r;
+    do {
+      r = Next();
+    } while (r < threshold);
+    return r % n;
+  }
+
+ private:
+  std::uint32_t seed_;
+  std::mt19937 engine_;
+};
+
+#endif  // RNG_H
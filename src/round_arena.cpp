@@ -0,0 +1,29 @@
+#include "round_arena.h"
+
+void *RoundArena::OverflowResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+  bytes_ += bytes;
+  return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void RoundArena::OverflowResource::do_deallocate(void *p, std::size_t bytes, std::size_t alignment) {
+  std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+RoundArena::RoundArena(std::size_t initial_bytes) { Allocate(initial_bytes); }
+
+void RoundArena::Reset() {
+  std::size_t overflow = overflow_.Bytes();
+  resource_->release();  // devolve ao heap o que veio dele
+  overflow_.ResetCount();
+  if (overflow > 0) {
+    // A rodada não coube: um bloco só, do tamanho que ela usou
+    resource_.reset();
+    Allocate(capacity_ + overflow);
+  }
+}
+
+void RoundArena::Allocate(std::size_t bytes) {
+  capacity_ = bytes;
+  buffer_.reset(new std::byte[bytes]);  // sem zerar
+  resource_.emplace(buffer_.get(), capacity_, &overflow_);
+}
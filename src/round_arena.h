@@ -0,0 +1,55 @@
+#ifndef ROUND_ARENA_H
+#define ROUND_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+// Memória de uma rodada (Simulation, Bot, replay, snapshots): um bloco
+// alocado uma vez com um monotonic_buffer_resource por cima. Alocar é
+// avançar um ponteiro, desalocar não faz nada, e Reset() devolve tudo de
+// uma vez. Se uma rodada passar do bloco, o excesso vem do heap e o
+// próximo Reset() aumenta o bloco para o que ela usou: depois da primeira
+// rodada, recomeçar não toca no heap.
+//
+// Não é thread-safe: só a thread do jogo aloca dele. Tudo que foi
+// alocado precisa ser destruído antes de Reset().
+class RoundArena {
+ public:
+  explicit RoundArena(std::size_t initial_bytes = std::size_t{1} << 20);
+
+  RoundArena(const RoundArena&) = delete;
+  RoundArena& operator=(const RoundArena&) = delete;
+
+  std::pmr::memory_resource *Resource() { return &*resource_; }
+  void Reset();
+
+  std::size_t Capacity() const { return capacity_; }
+  // Bytes que a rodada atual precisou pedir ao heap além do bloco
+  std::size_t OverflowBytes() const { return overflow_.Bytes(); }
+
+ private:
+  // Repassa ao heap contando quanto saiu do bloco
+  class OverflowResource : public std::pmr::memory_resource {
+   public:
+    std::size_t Bytes() const { return bytes_; }
+    void ResetCount() { bytes_ = 0; }
+
+   private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    std::size_t bytes_{0};
+  };
+
+  void Allocate(std::size_t bytes);
+
+  OverflowResource overflow_;
+  std::unique_ptr<std::byte[]> buffer_;
+  std::size_t capacity_{0};
+  std::optional<std::pmr::monotonic_buffer_resource> resource_;
+};
+
+#endif  // ROUND_ARENA_H
@@ -0,0 +1,250 @@
+#include "score_log.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SCORE_LOG_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char kLogMagic[8] = {'S', 'N', 'K', 'L', 'O', 'G', '0', '1'};
+constexpr char kIndexMagic[8] = {'S', 'N', 'K', 'I', 'D', 'X', '0', '1'};
+constexpr std::uint32_t kVersion = 1;
+
+struct IndexHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t count;
+    std::uint64_t log_count;
+};
+static_assert(sizeof(IndexHeader) == 24, "IndexHeader layout must stay fixed");
+
+std::uint32_t RecordCrc(const ScoreRecord &record) {
+    return Crc32(&record, offsetof(ScoreRecord, crc));
+}
+
+}  // namespace
+
+std::uint32_t Crc32(const void *data, std::size_t size, std::uint32_t crc) {
+    // CRC-32 (IEEE), tabela montada na primeira chamada
+    static const auto table = [] {
+        std::vector<std::uint32_t> t(256);
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+ScoreRecord MakeScoreRecord(const std::string &name, int score, std::int64_t timestamp) {
+    ScoreRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.timestamp = timestamp;
+    record.score = score;
+    record.name_len = static_cast<std::uint8_t>(std::min(name.size(), sizeof(record.name)));
+    std::memcpy(record.name, name.data(), record.name_len);
+    record.crc = RecordCrc(record);
+    return record;
+}
+
+std::string RecordName(const ScoreRecord &record) {
+    return std::string(record.name, std::min<std::size_t>(record.name_len, sizeof(record.name)));
+}
+
+bool RecordValid(const ScoreRecord &record) {
+    return record.name_len <= sizeof(record.name) && record.crc == RecordCrc(record);
+}
+
+ScoreLog::~ScoreLog() {
+    if (file_) std::fclose(file_);
+}
+
+bool ScoreLog::Open(const std::string &path) {
+    path_ = path;
+    file_ = std::fopen(path.c_str(), "r+b");
+    if (!file_) {
+        // Arquivo ainda não existe: cria com cabeçalho vazio
+        file_ = std::fopen(path.c_str(), "w+b");
+        if (!file_) {
+            std::cerr << "Failed to open score log: " << path << std::endl;
+            return false;
+        }
+        count_ = 0;
+        return WriteHeader() && Sync();
+    }
+
+    Header header;
+    bool header_read = std::fread(&header, sizeof(header), 1, file_) == 1;
+    if (header_read && std::memcmp(header.magic, kLogMagic, sizeof(kLogMagic)) != 0) {
+        std::cerr << "Not a score log: " << path << std::endl;
+        std::fclose(file_);
+        file_ = nullptr;
+        return false;
+    }
+    bool header_valid = header_read && header.version == kVersion &&
+                        header.record_size == sizeof(ScoreRecord) &&
+                        header.crc == Crc32(&header, offsetof(Header, crc));
+    count_ = header_valid ? header.count : 0;
+    Recover(header_valid);
+    return true;
+}
+
+void ScoreLog::Recover(bool header_valid) {
+    // Cabeçalho válido: só olha além do contador. Cabeçalho corrompido:
+    // recontar do início (caminho lento, só depois de uma queda).
+    std::uint64_t before = count_;
+    std::fseek(file_, Offset(count_), SEEK_SET);
+    ScoreRecord record;
+    while (std::fread(&record, sizeof(record), 1, file_) == 1 && RecordValid(record)) {
+        ++count_;
+    }
+    if (!header_valid || count_ != before) {
+        WriteHeader();
+        Sync();
+    }
+}
+
+long ScoreLog::Offset(std::uint64_t index) const {
+    return static_cast<long>(sizeof(Header) + index * sizeof(ScoreRecord));
+}
+
+bool ScoreLog::WriteHeader() {
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kLogMagic, sizeof(kLogMagic));
+    header.version = kVersion;
+    header.record_size = sizeof(ScoreRecord);
+    header.count = count_;
+    header.crc = Crc32(&header, offsetof(Header, crc));
+    return std::fseek(file_, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file_) == 1;
+}
+
+bool ScoreLog::Sync() {
+    if (std::fflush(file_) != 0) return false;
+#ifdef SCORE_LOG_POSIX
+    return ::fsync(fileno(file_)) == 0;
+#else
+    return true;
+#endif
+}
+
+bool ScoreLog::Append(const std::vector<ScoreRecord> &records) {
+    if (!file_) return false;
+    if (records.empty()) return true;
+    // Registros primeiro; o contador no cabeçalho só avança depois deles no disco
+    if (std::fseek(file_, Offset(count_), SEEK_SET) != 0 ||
+        std::fwrite(records.data(), sizeof(ScoreRecord), records.size(), file_) != records.size() ||
+        !Sync()) {
+        std::cerr << "Failed to append to score log: " << path_ << std::endl;
+        return false;
+    }
+    count_ += records.size();
+    return WriteHeader() && Sync();
+}
+
+void ScoreLog::ForEach(std::uint64_t first, const std::function<void(const ScoreRecord&)> &fn) const {
+    if (!file_ || first >= count_) return;
+#ifdef SCORE_LOG_POSIX
+    std::size_t length = static_cast<std::size_t>(Offset(count_));
+    void *map = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fileno(file_), 0);
+    if (map != MAP_FAILED) {
+        const auto *records = reinterpret_cast<const ScoreRecord *>(
+            static_cast<const char *>(map) + sizeof(Header));
+        ::madvise(map, length, MADV_SEQUENTIAL);
+        for (std::uint64_t i = first; i < count_; ++i) {
+            if (RecordValid(records[i])) fn(records[i]);
+        }
+        ::munmap(map, length);
+        return;
+    }
+#endif
+    // Sem mmap: leitura em blocos
+    std::vector<ScoreRecord> chunk(4096);
+    std::fseek(file_, Offset(first), SEEK_SET);
+    for (std::uint64_t i = first; i < count_;) {
+        std::size_t want = static_cast<std::size_t>(std::min<std::uint64_t>(chunk.size(), count_ - i));
+        std::size_t got = std::fread(chunk.data(), sizeof(ScoreRecord), want, file_);
+        for (std::size_t k = 0; k < got; ++k) {
+            if (RecordValid(chunk[k])) fn(chunk[k]);
+        }
+        if (got < want) break;
+        i += got;
+    }
+}
+
+bool LoadTopKIndex(const std::string &path, std::vector<ScoreRecord> &top, std::uint64_t &log_count) {
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    IndexHeader header;
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1 &&
+              std::memcmp(header.magic, kIndexMagic, sizeof(kIndexMagic)) == 0 &&
+              header.version == kVersion && header.count <= (1u << 20);
+    std::vector<ScoreRecord> entries;
+    std::uint32_t stored_crc = 0;
+    if (ok) {
+        entries.resize(header.count);
+        ok = std::fread(entries.data(), sizeof(ScoreRecord), entries.size(), file) == entries.size() &&
+             std::fread(&stored_crc, sizeof(stored_crc), 1, file) == 1;
+    }
+    std::fclose(file);
+    if (!ok) return false;
+
+    std::uint32_t crc = Crc32(&header, sizeof(header));
+    crc = Crc32(entries.data(), entries.size() * sizeof(ScoreRecord), crc);
+    if (crc != stored_crc) return false;
+    top = std::move(entries);
+    log_count = header.log_count;
+    return true;
+}
+
+bool SaveTopKIndex(const std::string &path, const std::vector<ScoreRecord> &top, std::uint64_t log_count) {
+    IndexHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+    header.version = kVersion;
+    header.count = static_cast<std::uint32_t>(top.size());
+    header.log_count = log_count;
+    std::uint32_t crc = Crc32(&header, sizeof(header));
+    crc = Crc32(top.data(), top.size() * sizeof(ScoreRecord), crc);
+
+    std::FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to open score index for writing: " << path << std::endl;
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(top.data(), sizeof(ScoreRecord), top.size(), file) == top.size() &&
+              std::fwrite(&crc, sizeof(crc), 1, file) == 1 && std::fflush(file) == 0;
+#ifdef SCORE_LOG_POSIX
+    // Dados no disco antes de quem chamou trocar o índice pelo rename: sem
+    // isso, uma queda logo depois pode deixar um .idx de tamanho zero
+    ok = ok && ::fsync(fileno(file)) == 0;
+#endif
+    return std::fclose(file) == 0 && ok;
+}
+
+bool SyncParentDirectory(const std::string &path) {
+#ifdef SCORE_LOG_POSIX
+    std::string::size_type slash = path.find_last_of('/');
+    std::string dir = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+    int fd = ::open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = ::fsync(fd) == 0;
+    return ::close(fd) == 0 && ok;
+#else
+    (void)path;
+    return true;
+#endif
+}
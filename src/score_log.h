@@ -0,0 +1,83 @@
+#ifndef SCORE_LOG_H
+#define SCORE_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Um registro de partida, gravado como está (host endian, 40 bytes).
+// O CRC cobre todos os campos anteriores e detecta gravações cortadas.
+struct ScoreRecord {
+  std::int64_t timestamp;  // segundos desde a época Unix
+  std::int32_t score;
+  std::uint8_t name_len;
+  char name[23];           // nomes maiores são truncados
+  std::uint32_t crc;
+};
+static_assert(sizeof(ScoreRecord) == 40, "ScoreRecord layout must stay fixed");
+
+ScoreRecord MakeScoreRecord(const std::string &name, int score, std::int64_t timestamp);
+std::string RecordName(const ScoreRecord &record);
+bool RecordValid(const ScoreRecord &record);
+std::uint32_t Crc32(const void *data, std::size_t size, std::uint32_t crc = 0);
+
+// Log binário só de acréscimo com todas as partidas já jogadas.
+// Layout: cabeçalho de 32 bytes (magic, versão, número de registros
+// confirmados, CRC do cabeçalho) seguido de registros de tamanho fixo.
+// Append grava os registros, sincroniza e só então atualiza o contador no
+// cabeçalho; ao abrir, registros válidos além do contador (queda entre as
+// duas gravações) são recuperados e um final cortado é ignorado.
+class ScoreLog {
+ public:
+  ScoreLog() = default;
+  ~ScoreLog();
+
+  ScoreLog(const ScoreLog&) = delete;
+  ScoreLog& operator=(const ScoreLog&) = delete;
+
+  // Abre ou cria o log. Retorna false se o arquivo não pode ser usado.
+  bool Open(const std::string &path);
+  bool IsOpen() const { return file_ != nullptr; }
+
+  bool Append(const std::vector<ScoreRecord> &records);
+  std::uint64_t Count() const { return count_; }
+
+  // Percorre os registros [first, Count()) lendo o arquivo mapeado em
+  // memória (POSIX) ou em blocos; registros com CRC inválido são pulados.
+  void ForEach(std::uint64_t first, const std::function<void(const ScoreRecord&)> &fn) const;
+
+ private:
+  struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint64_t count;
+    std::uint32_t reserved;
+    std::uint32_t crc;
+  };
+  static_assert(sizeof(Header) == 32, "Header layout must stay fixed");
+
+  bool WriteHeader();
+  bool Sync();
+  void Recover(bool header_valid);
+  long Offset(std::uint64_t index) const;
+
+  std::string path_;
+  std::FILE *file_{nullptr};
+  std::uint64_t count_{0};
+};
+
+// Índice em disco com as K melhores pontuações e quantos registros do log
+// ele já cobre; um CRC final invalida índices cortados.
+bool LoadTopKIndex(const std::string &path, std::vector<ScoreRecord> &top, std::uint64_t &log_count);
+// Grava e faz fsync do arquivo antes de retornar.
+bool SaveTopKIndex(const std::string &path, const std::vector<ScoreRecord> &top, std::uint64_t log_count);
+
+// fsync do diretório de path, para um rename feito nele sobreviver a uma
+// queda (só POSIX; nos outros sistemas não faz nada).
+bool SyncParentDirectory(const std::string &path);
+
+#endif  // SCORE_LOG_H
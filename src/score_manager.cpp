@@ -2,92 +2,188 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
 #include <thread>
 #include <iostream>
 
-ScoreManager::ScoreManager(const std::string& filename) : filename_(filename) {
-    scores_ = LoadScores();
+namespace {
+
+std::int64_t UnixNow() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace
+
+ScoreManager::ScoreManager(const std::string& base_path)
+    : log_path_(base_path + ".log"), index_path_(base_path + ".idx") {
+    if (log_.Open(log_path_) && log_.Count() == 0) {
+        ImportLegacyScores(base_path + ".txt");
+    }
+    LoadScores();
+    writer_thread_ = std::thread(&ScoreManager::WriterLoop, this);
 }
 
 ScoreManager::~ScoreManager() {
-    // Aguarda a thread de salvamento terminar antes de destruir objeto
-    if (saver_thread_.joinable()) {
-        saver_thread_.join();
+    // A thread de escrita grava o que ainda estiver pendente antes de sair
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    writer_cv_.notify_one();
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
     }
 }
 
 void ScoreManager::AddScore(const std::string& name, int score) {
+    ScoreRecord record = MakeScoreRecord(name, score, UnixNow());
+    // Placar e pending_ mudam juntos sob o mutex: o top-K que a thread de
+    // escrita lê ao pegar pending_ cobre exatamente o que vai para o log,
+    // nem mais (um .idx com registro fora do log) nem menos
     std::lock_guard<std::mutex> lock(mutex_);
-    scores_.push_back({name, score});
-    std::sort(scores_.begin(), scores_.end(), [](const ScoreEntry& a, const ScoreEntry& b) {
-        return b.score < a.score;  // Descrescente
-    });
-    if (scores_.size() > 20) scores_.resize(20);
+    board_.Submit(record);
+    pending_.push_back(record);
 }
 
-std::vector<ScoreEntry> ScoreManager::GetHighScores(int topN) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if ((int)scores_.size() > topN) {
-        return std::vector<ScoreEntry>(scores_.begin(), scores_.begin() + topN);
+std::vector<ScoreEntry> ScoreManager::GetHighScores(int topN) const {
+    std::vector<ScoreRecord> top = board_.Sorted();
+    std::size_t n = std::min(top.size(), static_cast<std::size_t>(std::max(topN, 0)));
+    std::vector<ScoreEntry> result;
+    result.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        result.push_back({RecordName(top[i]), top[i].score, top[i].timestamp});
     }
-    return scores_;
+    return result;
 }
 
-void ScoreManager::SaveScores(const std::vector<ScoreEntry>& scores) {
-    std::ofstream file(filename_);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open score file for writing: " << filename_ << std::endl;
-        return;
+std::uint64_t ScoreManager::TotalScores() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return saved_count_ + pending_.size();
+}
+
+bool ScoreManager::SaveScores(const std::vector<ScoreRecord>& pending, const std::vector<ScoreRecord>& top) {
+    // Só acrescenta as partidas novas; o log nunca é reescrito
+    if (!log_.Append(pending)) return false;
+    return ReplaceIndex(top);
+}
+
+bool ScoreManager::ReplaceIndex(const std::vector<ScoreRecord>& top) {
+    // O índice é pequeno: grava num temporário e troca pelo rename, assim
+    // uma queda nunca deixa um índice pela metade
+    std::string tmp_path = index_path_ + ".tmp";
+    if (!SaveTopKIndex(tmp_path, top, log_.Count())) return false;
+    if (std::rename(tmp_path.c_str(), index_path_.c_str()) != 0) {
+        // Windows não substitui um destino existente
+        std::remove(index_path_.c_str());
+        if (std::rename(tmp_path.c_str(), index_path_.c_str()) != 0) {
+            std::cerr << "Failed to replace score index: " << index_path_ << std::endl;
+            return false;
+        }
     }
-    for (const auto& entry : scores) {
-        file << entry.name << "," << entry.score << "\n";
+    // O temporário já foi para o disco (SaveTopKIndex); falta a troca de nome
+    if (!SyncParentDirectory(index_path_)) {
+        std::cerr << "Failed to sync score index directory: " << index_path_ << std::endl;
+        return false;
     }
+    return true;
 }
 
 std::future<void> ScoreManager::SaveScoresAsync() {
-    // Cria promise e future para notificação
-    save_promise_ = std::promise<void>();
-    std::future<void> fut = save_promise_.get_future();
-
-    // Copia os scores protegidos por mutex
-    std::vector<ScoreEntry> scores_copy;
+    std::promise<void> request;
+    std::future<void> fut = request.get_future();
     {
-      std::lock_guard<std::mutex> lock(mutex_);
-      scores_copy = scores_;
+        std::lock_guard<std::mutex> lock(mutex_);
+        save_requests_.push_back(std::move(request));
     }
+    writer_cv_.notify_one();
+    return fut;
+}
 
-    // Se existir thread anterior rodando, aguarda
-    if (saver_thread_.joinable()) {
-        saver_thread_.join();
-    }
+void ScoreManager::WriterLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        writer_cv_.wait(lock, [this] { return stop_ || !save_requests_.empty(); });
+        if (!stop_) {
+            // Junta a rajada: pedidos que chegarem na janela vão na mesma escrita
+            writer_cv_.wait_for(lock, kCoalesceWindow, [this] { return stop_; });
+        }
+        if (save_requests_.empty() && pending_.empty()) {
+            if (stop_) return;
+            continue;
+        }
 
-    // Cria nova thread para salvar em background
-    saver_thread_ = std::thread([this, scores_copy]() mutable {
-        SaveScores(scores_copy);
-        save_promise_.set_value();
-    });
+        // Separa as partidas pendentes e o top-K que as inclui
+        std::vector<std::promise<void>> requests;
+        std::vector<ScoreRecord> pending;
+        requests.swap(save_requests_);
+        pending.swap(pending_);
+        saved_count_ += pending.size();
+        std::vector<ScoreRecord> top = board_.Sorted();
+        bool stopping = stop_;
 
-    return fut;
+        lock.unlock();
+        std::uint64_t logged = log_.Count();
+        bool ok = SaveScores(pending, top);
+        for (auto& request : requests) {
+            if (ok) {
+                request.set_value();
+            } else {
+                request.set_exception(std::make_exception_ptr(
+                    std::runtime_error("failed to save scores to " + log_path_)));
+            }
+        }
+        lock.lock();
+        if (!ok && log_.Count() == logged) {
+            // Nada chegou ao log: as partidas voltam para a próxima tentativa
+            pending_.insert(pending_.begin(), pending.begin(), pending.end());
+            saved_count_ -= pending.size();
+        }
+        // Encerrando: esta foi a última tentativa
+        if (stopping) return;
+    }
+}
+
+void ScoreManager::LoadScores() {
+    std::uint64_t indexed = 0;
+    std::vector<ScoreRecord> top;
+    if (LoadTopKIndex(index_path_, top, indexed) && indexed <= log_.Count()) {
+        for (const auto& record : top) board_.Submit(record);
+    } else {
+        indexed = 0;
+    }
+    // Normalmente o índice já cobre o log inteiro e nada é lido; depois de
+    // uma queda só a cauda não indexada é percorrida
+    log_.ForEach(indexed, [this](const ScoreRecord& record) { board_.Submit(record); });
+    saved_count_ = log_.Count();
+    if (indexed != log_.Count() && !ReplaceIndex(board_.Sorted())) {
+        // Não é fatal: o próximo salvamento tenta de novo
+        std::cerr << "Failed to rebuild score index: " << index_path_ << std::endl;
+    }
 }
 
-std::vector<ScoreEntry> ScoreManager::LoadScores() {
-    std::vector<ScoreEntry> loaded_scores;
-    std::ifstream file(filename_);
+void ScoreManager::ImportLegacyScores(const std::string& filename) {
+    std::ifstream file(filename);
     if (!file.is_open()) {
-        // Arquivo pode não existir ainda, não é erro fatal
-        return loaded_scores;
+        // Arquivo pode não existir, não é erro fatal
+        return;
     }
+    std::vector<ScoreRecord> imported;
     std::string line;
     while (std::getline(file, line)) {
         std::stringstream ss(line);
         std::string name, scoreStr;
         if (std::getline(ss, name, ',') && std::getline(ss, scoreStr)) {
             try {
-                loaded_scores.push_back({name, std::stoi(scoreStr)});
+                imported.push_back(MakeScoreRecord(name, std::stoi(scoreStr), 0));
             } catch (...) {
                 // Ignorar linhas inválidas
             }
         }
     }
-    return loaded_scores;
+    if (log_.Append(imported)) {
+        std::cout << "Imported " << imported.size() << " scores from " << filename << std::endl;
+    }
 }
@@ -1,36 +1,68 @@
 #ifndef SCORE_MANAGER_H
 #define SCORE_MANAGER_H
 
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <mutex>
 #include <future>
+#include <thread>
+#include "leaderboard.h"
+#include "score_log.h"
 
 struct ScoreEntry {
     std::string name;
     int score;
+    std::int64_t timestamp{0};
 };
 
+// Todas as partidas ficam em <base>.log (binário, só acréscimo); as
+// kTopK melhores ficam também em <base>.idx, lido na inicialização sem
+// percorrer o log. Um <base>.txt antigo é importado na primeira execução.
+// Toda gravação em disco acontece numa única thread de escrita que vive
+// tanto quanto o ScoreManager.
 class ScoreManager {
  public:
-  explicit ScoreManager(const std::string& filename);
+  static constexpr std::size_t kTopK = 100;
+  // Pedidos de salvamento que chegam dentro dessa janela viram uma escrita só
+  static constexpr std::chrono::milliseconds kCoalesceWindow{20};
+
+  explicit ScoreManager(const std::string& base_path);
   ~ScoreManager();
 
   void AddScore(const std::string& name, int score);
-  std::vector<ScoreEntry> GetHighScores(int topN = 20);
+  // Seguro de qualquer thread; não bloqueia quem está registrando pontos
+  std::vector<ScoreEntry> GetHighScores(int topN = 20) const;
+
+  // Partidas registradas no log, incluindo as ainda não salvas
+  std::uint64_t TotalScores();
 
-  // Método para salvar scores assincronamente (retorna future para aguardar conclusão)
+  // Enfileira um salvamento e retorna na hora; o future fica pronto quando
+  // uma escrita que inclui tudo o que foi adicionado até aqui termina (ou
+  // guarda a exceção se a escrita falhar). Não precisa ser aguardado.
   std::future<void> SaveScoresAsync();
 
  private:
-  void SaveScores(const std::vector<ScoreEntry>& scores);
-  std::vector<ScoreEntry> LoadScores();
-
-  std::string filename_;
-  std::mutex mutex_;  // Protege acesso a scores
-  std::vector<ScoreEntry> scores_;  // Cache local
-  std::promise<void> save_promise_;
-  std::thread saver_thread_;
+  void WriterLoop();
+  bool SaveScores(const std::vector<ScoreRecord>& pending, const std::vector<ScoreRecord>& top);
+  // Troca o índice por um novo com top, via arquivo temporário + rename
+  bool ReplaceIndex(const std::vector<ScoreRecord>& top);
+  void LoadScores();
+  void ImportLegacyScores(const std::string& filename);
+
+  std::string log_path_;
+  std::string index_path_;
+  ScoreLog log_;  // só a thread de salvamento grava depois da inicialização
+  Leaderboard board_{kTopK};
+  std::mutex mutex_;  // Protege pending_, save_requests_, stop_ e as escritas em board_
+  std::condition_variable writer_cv_;
+  std::vector<ScoreRecord> pending_;  // ainda não gravados no log
+  std::vector<std::promise<void>> save_requests_;
+  std::uint64_t saved_count_{0};
+  bool stop_{false};
+  std::thread writer_thread_;  // iniciada por último no construtor
 };
 
 #endif  // SCORE_MANAGER_H
@@ -0,0 +1,22 @@
+#include "settings.h"
+
+int GetNumObstaclesForDifficulty(Difficulty diff, std::size_t grid_cells) {
+    int base;
+    switch (diff) {
+        case Difficulty::Easy:   base = 5; break;
+        case Difficulty::Medium: base = 15; break;
+        case Difficulty::Hard:   base = 30; break;
+        default: base = 10; break;
+    }
+    if (grid_cells <= kReferenceGridCells) return base;
+    return static_cast<int>(static_cast<unsigned long long>(base) * grid_cells / kReferenceGridCells);
+}
+
+float GetSpeedForOption(SpeedOption option) {
+    switch (option) {
+        case SpeedOption::Slow:   return 0.07f;
+        case SpeedOption::Medium: return 0.10f;
+        case SpeedOption::Fast:   return 0.16f;
+        default: return 0.10f;
+    }
+}
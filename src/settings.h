@@ -0,0 +1,18 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <cstddef>
+
+// Presets de dificuldade e velocidade, compartilhados pelo jogo e pelo
+// snake_batch (que os usa para calibrar as opções).
+enum class Difficulty { Easy, Medium, Hard };
+enum class SpeedOption { Slow, Medium, Fast };
+
+// Os presets valem para a grade clássica de 32x32; grades maiores recebem
+// obstáculos proporcionais à área, mantendo a densidade.
+constexpr std::size_t kReferenceGridCells = 32 * 32;
+
+int GetNumObstaclesForDifficulty(Difficulty diff, std::size_t grid_cells = kReferenceGridCells);
+float GetSpeedForOption(SpeedOption option);
+
+#endif  // SETTINGS_H
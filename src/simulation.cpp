@@ -0,0 +1,216 @@
+#include "simulation.h"
+#include <algorithm>
+
+Simulation::Simulation(std::size_t grid_width, std::size_t grid_height, float snake_speed, int num_obstacles,
+                       std::uint32_t seed, std::pmr::memory_resource *resource)
+    : grid(static_cast<int>(grid_width), static_cast<int>(grid_height), resource),
+      snake(grid_width, grid_height, snake_speed, resource),
+      timers(256, resource),
+      rng(seed),
+      obstacles(resource),
+      num_obstacles_(num_obstacles),
+      base_speed_(snake.speed) {
+  obstacles.reserve(static_cast<std::size_t>(std::min(std::max(num_obstacles, 0), grid.FreeCount())));
+  snake.AttachGrid(&grid);
+  // Sem célula livre já no início: acaba como em Step, antes do primeiro tick
+  state_.board_full = !PlaceFood();
+  PlaceObstacles();
+}
+
+const SimState &Simulation::Step(const SimInput &input) {
+    if (IsOver()) return state_;
+    ApplyInput(input);
+    Update();
+    state_.tick++;
+    state_.size = snake.size;
+    state_.alive = snake.alive;
+    return state_;
+}
+
+void Simulation::Reset(std::uint32_t seed, ObstacleLayout layout) {
+    grid.Reset();
+    snake.Reset(base_speed_);
+    snake.AttachGrid(&grid);
+    timers.Reset();
+    bonus_timer = TimerWheel::Handle{};
+    speed_timer = TimerWheel::Handle{};
+    rng.Reseed(seed);
+    food = Food{{-1, -1}, FoodType::Normal};
+    bonus_food = Food{{-1, -1}, FoodType::SpecialScore};
+    bonus_food_active = false;
+    state_ = SimState{};
+    foods_eaten_ = 0;
+
+    if (layout == ObstacleLayout::Keep) {
+        // Mesma ordem de antes: a grade fica igual para o mesmo layout
+        for (const auto& obs : obstacles) grid.Set(obs.x, obs.y, OccupancyGrid::kObstacle);
+        state_.board_full = !PlaceFood();
+    } else {
+        // Mesma sequência do construtor, então os mesmos sorteios
+        state_.board_full = !PlaceFood();
+        PlaceObstacles();
+    }
+}
+
+void Simulation::ApplyInput(const SimInput &input) {
+    if (!input.turn) return;
+    // Direções (não permitir inversão)
+    Snake::Direction opposite = Snake::Direction::kUp;
+    switch (input.direction) {
+        case Snake::Direction::kUp:    opposite = Snake::Direction::kDown; break;
+        case Snake::Direction::kDown:  opposite = Snake::Direction::kUp; break;
+        case Snake::Direction::kLeft:  opposite = Snake::Direction::kRight; break;
+        case Snake::Direction::kRight: opposite = Snake::Direction::kLeft; break;
+    }
+    if (snake.direction != opposite) {
+        snake.direction = input.direction;
+    }
+}
+
+bool Simulation::PlaceFood() {
+    // Tira a comida antiga da grade; o sorteio é direto no conjunto de livres
+    if (food.pos.x >= 0) grid.Clear(food.pos.x, food.pos.y, OccupancyGrid::kFood);
+    food.pos.x = -1;
+    food.pos.y = -1;
+    int x, y;
+    if (!RandomFreeCell(x, y)) return false; // tabuleiro cheio
+
+    // Escolha do tipo de comida
+    foods_eaten_++;
+    FoodType type = FoodType::Normal;
+
+    if (foods_eaten_ % 5 == 0) {
+        type = FoodType::SpecialScore; // a cada 5 comidas, vermelha
+    } else {
+        std::uint32_t r = rng.UniformInt(10);
+        if (r == 0) type = FoodType::SpeedUp; // ~10% chance rosa
+        else if (r == 1) type = FoodType::SlowDown; // ~10% chance branca
+        // senão, normal (amarela)
+    }
+
+    food.pos.x = x;
+    food.pos.y = y;
+    food.type = type;
+    grid.Set(x, y, OccupancyGrid::kFood);
+    return true;
+}
+
+bool Simulation::RandomFreeCell(int &x, int &y) {
+    if (grid.FreeCount() == 0) return false;
+    grid.FreeCell(static_cast<int>(rng.UniformInt(static_cast<std::uint32_t>(grid.FreeCount()))), x, y);
+    return true;
+}
+
+void Simulation::Update() {
+    // Atualiza a posição da Snake a cada tick; comida e obstáculos só
+    // podem estar numa célula em que a cabeça acabou de entrar
+    bool crossed = snake.Update();
+    if (!snake.alive && state_.death_cause == DeathCause::None) {
+        state_.death_cause = DeathCause::SelfCollision;
+    }
+    if (crossed) OnCellEntered(snake.LastCrossing().to.x, snake.LastCrossing().to.y);
+
+    // Ativa o bônus a cada 10 pontos (pode ajustar a regra)
+    if (state_.score > 0 && state_.score % 10 == 0 && !bonus_food_active) {
+        StartBonusFood();
+    }
+
+    // Dispara os prazos vencidos neste tick (bônus, efeito de velocidade)
+    timers.Advance([this](TimedEvent event) { OnTimer(event); });
+}
+
+void Simulation::OnCellEntered(int new_x, int new_y) {
+    // Checa colisão com obstáculos
+    if (grid.Has(new_x, new_y, OccupancyGrid::kObstacle)) {
+        snake.alive = false;
+        if (state_.death_cause == DeathCause::None) state_.death_cause = DeathCause::Obstacle;
+    }
+
+    // Checa se pegou comida normal
+    if (food.pos.x == new_x && food.pos.y == new_y) {
+        switch (food.type) {
+            case FoodType::Normal:
+                state_.score += 1;
+                snake.GrowBody();
+                break;
+            case FoodType::SpecialScore:
+                state_.score += 5;
+                snake.GrowBody();
+                snake.GrowBody(); // crescimento duplo
+                break;
+            case FoodType::SpeedUp:
+                state_.score += 1;
+                ApplySpeedEffect(3, 2); // aumenta velocidade
+                break;
+            case FoodType::SlowDown:
+                state_.score += 1;
+                ApplySpeedEffect(1, 2); // diminui velocidade
+                break;
+        }
+        if (!PlaceFood()) {
+            state_.board_full = true;
+        }
+    }
+
+    // Checa se pegou a comida bônus
+    if (bonus_food_active && bonus_food.pos.x == new_x && bonus_food.pos.y == new_y) {
+        state_.score += 10; // valor do bônus, pode ajustar
+        bonus_food_active = false;
+        timers.Cancel(bonus_timer);
+        bonus_food.pos.x = -1;
+        bonus_food.pos.y = -1;
+    }
+}
+
+void Simulation::ApplySpeedEffect(int num, int den) {
+    // Sempre a partir da base: sem erro acumulado entre efeitos
+    snake.speed = base_speed_ * num / den;
+    // Um novo efeito reinicia a contagem de 30 segundos de simulação
+    timers.Cancel(speed_timer);
+    speed_timer = timers.Schedule(kSpeedEffectTicks, TimedEvent::SpeedEffectExpire);
+}
+
+void Simulation::OnTimer(TimedEvent event) {
+    switch (event) {
+        case TimedEvent::BonusFoodExpire:
+            // Tempo acabou, remove a comida bônus
+            bonus_timer = TimerWheel::Handle{};
+            bonus_food_active = false;
+            bonus_food.pos.x = -1;
+            bonus_food.pos.y = -1;
+            break;
+        case TimedEvent::SpeedEffectExpire:
+            speed_timer = TimerWheel::Handle{};
+            snake.speed = base_speed_; // retorna ao normal
+            break;
+    }
+}
+
+void Simulation::PlaceObstacles() {
+    for (const auto& obs : obstacles)
+        grid.Clear(obs.x, obs.y, OccupancyGrid::kObstacle);
+    obstacles.clear();
+    // Avoid snake start position, food position and other obstacles
+    int x, y;
+    while (static_cast<int>(obstacles.size()) < num_obstacles_ && RandomFreeCell(x, y)) {
+        obstacles.push_back({x, y});
+        grid.Set(x, y, OccupancyGrid::kObstacle);
+    }
+}
+
+void Simulation::StartBonusFood() {
+    if (bonus_food_active) return; // Já existe um bônus ativo
+    if (!PlaceBonusFood()) return; // sem célula livre para o bônus
+    bonus_food_active = true;
+    bonus_timer = timers.Schedule(kBonusFoodTicks, TimedEvent::BonusFoodExpire);
+}
+
+bool Simulation::PlaceBonusFood() {
+    // Garante que não ocupa comida normal, obstáculos ou snake
+    int x, y;
+    if (!RandomFreeCell(x, y)) return false;
+    bonus_food.pos.x = x;
+    bonus_food.pos.y = y;
+    bonus_food.type = FoodType::SpecialScore; // Ou um tipo novo se quiser
+    return true;
+}
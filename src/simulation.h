@@ -0,0 +1,129 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "SDL.h"  // apenas o tipo SDL_Point; nenhuma chamada ao SDL
+#include "occupancy_grid.h"
+#include "rng.h"
+#include "snake.h"
+#include "timer_wheel.h"
+
+// Enum para tipos de comida
+enum class FoodType { Normal, SpecialScore, SpeedUp, SlowDown };
+
+// Estrutura para comida
+struct Food {
+    SDL_Point pos;
+    FoodType type;
+};
+
+// Entrada injetada em um tick: mudança de direção opcional.
+struct SimInput {
+  bool turn{false};
+  Snake::Direction direction{Snake::Direction::kUp};
+};
+
+enum class DeathCause { None, SelfCollision, Obstacle };
+
+// O que Simulation::Reset faz com os obstáculos da partida anterior.
+enum class ObstacleLayout { Regenerate, Keep };
+
+// Resumo do mundo depois de um tick.
+struct SimState {
+  unsigned long tick{0};
+  int score{0};
+  int size{1};
+  bool alive{true};
+  bool board_full{false};
+  DeathCause death_cause{DeathCause::None};
+};
+
+// Núcleo do jogo sem janela: avança o mundo um tick por Step() com a
+// entrada recebida e não depende de SDL_GetTicks, eventos ou renderer.
+class Simulation {
+ public:
+  // Taxa fixa da lógica; timers de efeito contam ticks, ou seja, tempo
+  // simulado, independente da taxa de quadros.
+  static constexpr int kTicksPerSecond = 60;
+  static constexpr int kBonusFoodTicks = 15 * kTicksPerSecond;
+  static constexpr int kSpeedEffectTicks = 30 * kTicksPerSecond;
+
+  // Toda aleatoriedade vem de um gerador por simulação: a mesma semente
+  // e as mesmas entradas reproduzem a partida. Grade, corpo, obstáculos e
+  // timers alocam de resource, em geral a RoundArena da rodada.
+  Simulation(std::size_t grid_width, std::size_t grid_height, float snake_speed, int num_obstacles,
+             std::uint32_t seed, std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  // A cobra aponta para a grade deste objeto
+  Simulation(const Simulation&) = delete;
+  Simulation& operator=(const Simulation&) = delete;
+
+  const SimState &Step(const SimInput &input = SimInput{});
+
+  // Recomeça a partida com outra semente reaproveitando toda a memória:
+  // zera grade, cobra, timers de efeito, comidas e contadores. Regenerate
+  // dá exatamente a partida de uma Simulation nova com essa semente; Keep
+  // mantém os obstáculos e só a comida sai da semente nova.
+  void Reset(std::uint32_t seed, ObstacleLayout layout = ObstacleLayout::Regenerate);
+
+  const SimState &State() const { return state_; }
+  bool IsOver() const { return !state_.alive || state_.board_full; }
+
+  const Snake &GetSnake() const { return snake; }
+  const Food &GetFood() const { return food; }
+  const Food &GetBonusFood() const { return bonus_food; }
+  bool BonusFoodActive() const { return bonus_food_active; }
+  const std::pmr::vector<SDL_Point> &Obstacles() const { return obstacles; }
+  const OccupancyGrid &Grid() const { return grid; }
+  std::uint32_t Seed() const { return rng.Seed(); }
+
+  // Posicionamento: um sorteio O(1) no conjunto de células livres.
+  // Retorna false quando o tabuleiro está cheio. Step chama ao comer;
+  // público para o snake_bench medir em qualquer ocupação.
+  bool PlaceFood();
+
+  // Delta por tick: células cujo conteúdo mudou (cabeça nova, cauda
+  // removida, comida comida/colocada), registradas no momento da mudança.
+  // Acumula entre ticks até ClearChangedCells, para quem desenha menos
+  // quadros que ticks. Desligado por padrão (snake_batch não precisa).
+  void TrackChangedCells(bool enabled) { grid.TrackChanges(enabled); }
+  const std::pmr::vector<int> &ChangedCells() const { return grid.ChangedCells(); }
+  void ClearChangedCells() { grid.ClearChanges(); }
+
+ private:
+  OccupancyGrid grid;
+  Snake snake;
+  Food food{{-1, -1}, FoodType::Normal};
+  Food bonus_food{{-1, -1}, FoodType::SpecialScore};
+  bool bonus_food_active{false};
+
+  // Prazos (bônus, efeito de velocidade) avançados junto com os ticks
+  TimerWheel timers;
+  TimerWheel::Handle bonus_timer;
+  TimerWheel::Handle speed_timer;
+
+  Rng rng;
+  std::pmr::vector<SDL_Point> obstacles;
+
+  SimState state_;
+  int num_obstacles_;
+  int foods_eaten_{0};  // a cada 5 comidas, uma especial
+
+  bool RandomFreeCell(int &x, int &y);
+  void ApplyInput(const SimInput &input);
+  void Update();
+  void OnCellEntered(int x, int y);
+  void PlaceObstacles();
+  void StartBonusFood();
+  bool PlaceBonusFood();
+  void ApplySpeedEffect(int num, int den);
+  void OnTimer(TimedEvent event);
+
+  // Velocidade sem efeito; um efeito vale base * num / den exatos em Q16
+  // e não se acumula com o anterior
+  Snake::Fixed base_speed_;
+};
+
+#endif  // SIMULATION_H
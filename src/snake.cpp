@@ -1,77 +1,151 @@
 #include "snake.h"
+#include <algorithm>
+#include "cell_kernels.h"
 #include <cmath>
 #include <iostream>
 
-void Snake::Update() {
-  SDL_Point prev_cell{
-      static_cast<int>(head_x),
-      static_cast<int>(
-          head_y)};  // We first capture the head's cell before updating.
+Snake::Fixed Snake::ToFixed(float cells) {
+  return static_cast<Fixed>(std::llround(static_cast<double>(cells) * kOne));
+}
+
+bool Snake::Update() {
+  // Keep the previous position so the renderer can interpolate between ticks.
+  prev_head_x = head_x;
+  prev_head_y = head_y;
+  SDL_Point prev_cell{HeadCellX(), HeadCellY()};  // We first capture the head's cell before updating.
   UpdateHead();
-  SDL_Point current_cell{
-      static_cast<int>(head_x),
-      static_cast<int>(head_y)};  // Capture the head's cell after updating.
+  SDL_Point current_cell{HeadCellX(), HeadCellY()};  // Capture the head's cell after updating.
 
   // Update all of the body vector items if the snake head has moved to a new
   // cell.
-  if (current_cell.x != prev_cell.x || current_cell.y != prev_cell.y) {
-    UpdateBody(current_cell, prev_cell);
-  }
+  if (current_cell.x == prev_cell.x && current_cell.y == prev_cell.y) return false;
+  crossing_ = {prev_cell, current_cell};
+  UpdateBody(current_cell, prev_cell);
+  return true;
 }
 
 void Snake::UpdateHead() {
-    switch (direction) {
-        case Direction::kUp:    head_y -= speed; break;
-        case Direction::kDown:  head_y += speed; break;
-        case Direction::kLeft:  head_x -= speed; break;
-        case Direction::kRight: head_x += speed; break;
-    }
-  // Wrap the Snake around to the beginning if going off of the screen.
-  head_x = fmod(head_x + grid_width, grid_width);
-  head_y = fmod(head_y + grid_height, grid_height);
+  // No máximo uma célula por tick, então a volta é uma só soma/subtração
+  const Fixed step = std::min(std::max(speed, Fixed{0}), kOne);
+  const Fixed width = static_cast<Fixed>(grid_width) << kFracBits;
+  const Fixed height = static_cast<Fixed>(grid_height) << kFracBits;
+  switch (direction) {
+    case Direction::kUp:
+      head_y -= step;
+      if (head_y < 0) head_y += height;
+      break;
+    case Direction::kDown:
+      head_y += step;
+      if (head_y >= height) head_y -= height;
+      break;
+    case Direction::kLeft:
+      head_x -= step;
+      if (head_x < 0) head_x += width;
+      break;
+    case Direction::kRight:
+      head_x += step;
+      if (head_x >= width) head_x -= width;
+      break;
+  }
 }
 
 void Snake::UpdateBody(SDL_Point &current_head_cell, SDL_Point &prev_head_cell) {
-  // Add previous head location to vector
+  // Add previous head location to vector. With a grid attached the cell is
+  // already marked, since it was the head.
   body.push_back(prev_head_cell);
+  if (!grid_) body_cells_.push_back(PackCell(prev_head_cell.x, prev_head_cell.y, grid_width));
 
   if (!growing) {
     // Remove the tail from the vector.
-    body.erase(body.begin());
+    if (grid_) {
+      grid_->Clear(body.front().x, body.front().y, OccupancyGrid::kSnake);
+    } else {
+      body_cells_.pop_front();
+    }
+    body.pop_front();
   } else {
     growing = false;
     size++;
   }
 
   // Check if the snake has died.
-  for (auto const &item : body) {
-    if (current_head_cell.x == item.x && current_head_cell.y == item.y) {
+  if (grid_) {
+    if (grid_->Has(current_head_cell.x, current_head_cell.y, OccupancyGrid::kSnake)) {
       alive = false;
     }
+    grid_->Set(current_head_cell.x, current_head_cell.y, OccupancyGrid::kSnake);
+    return;
+  }
+  if (BodyHas(PackCell(current_head_cell.x, current_head_cell.y, grid_width))) {
+    alive = false;
   }
 }
 
+bool Snake::BodyHas(std::uint32_t cell) const {
+  const std::uint32_t *first, *second;
+  std::size_t second_size;
+  std::size_t first_size = body_cells_.Spans(first, second, second_size);
+  return ContainsCell(first, first_size, cell) || ContainsCell(second, second_size, cell);
+}
+
+void Snake::RebuildBodyCells() {
+  body_cells_.clear();
+  if (grid_) return;
+  body_cells_.reserve(body.size());
+  for (auto const &item : body) body_cells_.push_back(PackCell(item.x, item.y, grid_width));
+}
+
 void Snake::GrowBody() { growing = true; }
 
-// Inefficient method to check if cell is occupied by snake.
-bool Snake::SnakeCell(int x, int y) {
-  if (x == static_cast<int>(head_x) && y == static_cast<int>(head_y)) {
-    return true;
-  }
+void Snake::Reset(Fixed initial_speed) {
+  head_x = static_cast<Fixed>(grid_width / 2) << kFracBits;
+  head_y = static_cast<Fixed>(grid_height / 2) << kFracBits;
+  prev_head_x = head_x;
+  prev_head_y = head_y;
+  speed = initial_speed;
+  direction = Direction::kUp;
+  size = 1;
+  alive = true;
+  growing = false;
+  crossing_ = {{0, 0}, {0, 0}};
+  body.clear();
+  body_cells_.clear();
+}
+
+void Snake::AttachGrid(OccupancyGrid *grid) {
+  grid_ = grid;
+  RebuildBodyCells();  // a grade substitui o espelho, e vice-versa
+  if (!grid_) return;
+  grid_->Set(HeadCellX(), HeadCellY(), OccupancyGrid::kSnake);
   for (auto const &item : body) {
-    if (x == item.x && y == item.y) {
-      return true;
-    }
+    grid_->Set(item.x, item.y, OccupancyGrid::kSnake);
   }
-  return false;
 }
 
-Snake::Snake(std::size_t grid_width, std::size_t grid_height, float initial_speed)
-    : grid_width(grid_width),
+// O(1) with a grid attached; falls back to a SIMD scan of the packed body.
+bool Snake::SnakeCell(int x, int y) const {
+  if (grid_) {
+    return grid_->Has(x, y, OccupancyGrid::kSnake);
+  }
+  if (x == HeadCellX() && y == HeadCellY()) {
+    return true;
+  }
+  return BodyHas(PackCell(x, y, grid_width));
+}
+
+Snake::Snake(std::size_t grid_width, std::size_t grid_height, float initial_speed,
+             std::pmr::memory_resource *resource)
+    : body_cells_(resource),
+      grid_width(grid_width),
       grid_height(grid_height),
-      head_x(grid_width / 2),
-      head_y(grid_height / 2),
-      speed(initial_speed){
+      head_x(static_cast<Fixed>(grid_width / 2) << kFracBits),
+      head_y(static_cast<Fixed>(grid_height / 2) << kFracBits),
+      prev_head_x(head_x),
+      prev_head_y(head_y),
+      speed(ToFixed(initial_speed)),
+      body(resource) {
+  // Reserve the whole grid up front so the hot path never reallocates.
+  body.reserve(std::min(grid_width * grid_height, kMaxReservedSegments));
 }
 
 // Copy constructor
@@ -80,12 +154,17 @@ Snake::Snake(const Snake& other)
       grid_height(other.grid_height),
       head_x(other.head_x),
       head_y(other.head_y),
+      prev_head_x(other.prev_head_x),
+      prev_head_y(other.prev_head_y),
       speed(other.speed),
       direction(other.direction),
       size(other.size),
       alive(other.alive),
       growing(other.growing),
-      body(other.body) {}
+      crossing_(other.crossing_),
+      body(other.body) {
+  RebuildBodyCells();
+}
 
 // Move constructor
 Snake::Snake(Snake&& other) noexcept
@@ -93,13 +172,19 @@ Snake::Snake(Snake&& other) noexcept
       grid_height(other.grid_height),
       head_x(other.head_x),
       head_y(other.head_y),
+      prev_head_x(other.prev_head_x),
+      prev_head_y(other.prev_head_y),
       speed(other.speed),
       direction(other.direction),
       size(other.size),
       alive(other.alive),
       growing(other.growing),
-      body(std::move(other.body)) {
+      crossing_(other.crossing_),
+      body(std::move(other.body)),
+      body_cells_(std::move(other.body_cells_)),
+      grid_(other.grid_) {
   // Reset other's state if necessary
+  other.grid_ = nullptr;
   other.size = 0;
   other.alive = false;
   other.growing = false;
@@ -112,13 +197,19 @@ Snake& Snake::operator=(Snake&& other) noexcept {
   grid_height = other.grid_height;
   head_x = other.head_x;
   head_y = other.head_y;
+  prev_head_x = other.prev_head_x;
+  prev_head_y = other.prev_head_y;
   speed = other.speed;
   direction = other.direction;
   size = other.size;
   alive = other.alive;
   growing = other.growing;
+  crossing_ = other.crossing_;
   body = std::move(other.body);
+  body_cells_ = std::move(other.body_cells_);
+  grid_ = other.grid_;
 
+  other.grid_ = nullptr;
   other.size = 0;
   other.alive = false;
   other.growing = false;
@@ -128,7 +219,7 @@ Snake& Snake::operator=(Snake&& other) noexcept {
 
 // Destructor
 Snake::~Snake() {
-  // Nothing special needed; vector cleans up automatically
+  // Nothing special needed; ring buffer cleans up automatically
 }
 
 // Copy assignment
@@ -138,11 +229,16 @@ Snake& Snake::operator=(const Snake& other) {
   grid_height = other.grid_height;
   head_x = other.head_x;
   head_y = other.head_y;
+  prev_head_x = other.prev_head_x;
+  prev_head_y = other.prev_head_y;
   speed = other.speed;
   direction = other.direction;
   size = other.size;
   growing = other.growing;
   alive = other.alive;
-  body = other.body;  // vector copy
+  crossing_ = other.crossing_;
+  body = other.body;  // ring buffer copy
+  grid_ = nullptr;    // copies are detached from the grid
+  RebuildBodyCells();
   return *this;
 }
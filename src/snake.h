@@ -1,15 +1,37 @@
 #ifndef SNAKE_H
 #define SNAKE_H
 
-#include <vector>
+#include <cstdint>
+#include <memory_resource>
 #include "SDL.h"
+#include "occupancy_grid.h"
+#include "ring_buffer.h"
+
+// Célula em que a cabeça entrou num Update (de from para to).
+struct CellCrossing {
+  SDL_Point from;
+  SDL_Point to;
+};
 
 class Snake {
  public:
   enum class Direction { kUp, kDown, kLeft, kRight };
 
-  // Construtor padrão
-  Snake(std::size_t grid_width, std::size_t grid_height, float initial_speed = 0.1f);
+  // Posições e velocidade em ponto fixo Q16: kOne é uma célula. Só soma e
+  // comparação de inteiros, então a passagem de célula é a mesma em
+  // qualquer compilador e flags. int64 cabe grades de até 2^47 células.
+  using Fixed = std::int64_t;
+  static constexpr int kFracBits = 16;
+  static constexpr Fixed kOne = Fixed{1} << kFracBits;
+
+  // Conversões: ToFixed arredonda para o Q16 mais próximo (exato para
+  // qualquer float, que é escalado por potência de dois)
+  static Fixed ToFixed(float cells);
+  static float ToFloat(Fixed value) { return static_cast<float>(static_cast<double>(value) / kOne); }
+
+  // Construtor padrão; o corpo aloca de resource (cópias usam o heap)
+  Snake(std::size_t grid_width, std::size_t grid_height, float initial_speed = 0.1f,
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
   // Rule of Five
   Snake(const Snake& other);                    // Copy constructor
@@ -18,26 +40,54 @@ class Snake {
   Snake& operator=(Snake&& other) noexcept;      // Move assignment
   ~Snake();                                     // Destructor
 
-  void Update();
+  // Avança a cabeça um tick. Retorna true quando ela entrou numa célula
+  // nova (no máximo uma por tick), descrita em LastCrossing().
+  bool Update();
+  const CellCrossing &LastCrossing() const { return crossing_; }
   void GrowBody();
-  bool SnakeCell(int x, int y);
+  bool SnakeCell(int x, int y) const;
+
+  // Estado de recém-construída (centro, para cima, tamanho 1) com a
+  // velocidade dada, reaproveitando o corpo já alocado. Não mexe na
+  // grade: quem a possui limpa e chama AttachGrid de novo.
+  void Reset(Fixed initial_speed);
+
+  // Liga a cobra a uma grade de ocupação compartilhada (não é dono dela).
+  // Com a grade ligada, SnakeCell e a auto-colisão são O(1); sem ela, são
+  // uma busca vetorizada (cell_kernels) nas células empacotadas do corpo.
+  // Cópias não herdam a grade; o move transfere.
+  void AttachGrid(OccupancyGrid *grid);
 
   // Estado público (para acesso simples)
   Direction direction = Direction::kUp;
-  float speed{0.1f};
+  Fixed speed{0};  // células por tick; acima de kOne anda kOne (não pula célula)
   int size{1};
   bool alive{true};
-  float head_x;
-  float head_y;
-  std::vector<SDL_Point> body;
+  Fixed head_x;
+  Fixed head_y;
+  Fixed prev_head_x;  // posição no tick anterior (interpolação)
+  Fixed prev_head_y;
+  RingBuffer<SDL_Point> body;  // cauda em front(), célula atrás da cabeça em back()
+
+  int HeadCellX() const { return static_cast<int>(head_x >> kFracBits); }
+  int HeadCellY() const { return static_cast<int>(head_y >> kFracBits); }
+
+  // Teto da reserva inicial do corpo; grades maiores crescem sob demanda.
+  static constexpr std::size_t kMaxReservedSegments = std::size_t{1} << 20;
 
  private:
   void UpdateHead();
   void UpdateBody(SDL_Point &current_cell, SDL_Point &prev_cell);
+  bool BodyHas(std::uint32_t cell) const;
+  void RebuildBodyCells();
 
+  // Espelho do corpo em índices y * largura + x, mantido só sem grade
+  RingBuffer<std::uint32_t> body_cells_;
   bool growing{false};
+  CellCrossing crossing_{{0, 0}, {0, 0}};
   int grid_width;
   int grid_height;
+  OccupancyGrid *grid_{nullptr};
 };
 
 #endif  // SNAKE_H
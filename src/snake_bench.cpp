@@ -0,0 +1,512 @@
+// snake_bench: mede os caminhos quentes do jogo e grava os resultados em
+// JSON para comparar entre commits (--json FILE, --label COMMIT).
+//
+//   snake_update/len=N   Snake::Update com a grade ligada, um passo de
+//                        célula por chamada; o custo deve ficar plano em N
+//   snake_cell/len=N     Snake::SnakeCell em células aleatórias
+//   place_food/fill=P    Simulation::PlaceFood com P% da grade ocupada
+//   find_cell/K/n=N      FindCellWith(K) sem acerto (varre as N células
+//                        empacotadas); K = scalar, sse2, avx2 se suportado
+//   round_reset/grid=N   RoundArena::Reset e montar Simulation, Bot e
+//                        SnapshotBuffer de uma rodada nova
+//   steady_tick/grid=N   um tick como no Game: Bot, Step, Publish, Acquire
+//                        (recomeça a rodada ao fim de cada partida)
+//   sim_reset/grid=N/L   Simulation::Reset com ObstacleLayout L (regenerate,
+//                        keep) sobre uma partida já jogada
+//   round_reset, steady_tick e sim_reset falham se alguma chamada a
+//   operator new acontecer depois do aquecimento: o regime permanente não
+//   pode alocar.
+//   scores_add/n=N       ScoreManager::AddScore, por chamada
+//   scores_save/n=N      SaveScoresAsync().get() com N pontuações pendentes
+//                        (inclui a janela de agrupamento do escritor)
+//   scores_load/n=N      construir o ScoreManager sobre N partidas gravadas
+//   render/...           Renderer::Render num renderer de software offscreen
+//
+// Harness próprio: cada caso dobra o número de iterações até passar de
+// --min-time segundos e reporta ns por operação.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "alloc_counter.h"
+#include "bot.h"
+#include "cell_kernels.h"
+#include "frame_snapshot.h"
+#include "renderer.h"
+#include "rng.h"
+#include "round_arena.h"
+#include "score_manager.h"
+#include "simulation.h"
+#include "snake.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchOptions {
+    std::string json_path;
+    std::string label;
+    std::string filter;
+    double min_time = 0.2;
+    bool quick = false;  // limita os tamanhos (para rodar em CI)
+};
+
+void PrintUsage() {
+    std::cout << "Usage: snake_bench [--json FILE] [--label NAME] [--filter SUBSTR]\n"
+                 "                   [--min-time SECONDS] [--quick]\n";
+}
+
+bool ParseArgs(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&](const char* name) -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument(std::string("missing value for ") + name);
+            return argv[++i];
+        };
+        if (arg == "--json") {
+            options.json_path = next("--json");
+        } else if (arg == "--label") {
+            options.label = next("--label");
+        } else if (arg == "--filter") {
+            options.filter = next("--filter");
+        } else if (arg == "--min-time") {
+            options.min_time = std::stod(next("--min-time"));
+        } else if (arg == "--quick") {
+            options.quick = true;
+        } else if (arg == "--help" || arg == "-h") {
+            return false;
+        } else {
+            throw std::invalid_argument("unknown option: " + arg);
+        }
+    }
+    return true;
+}
+
+struct Result {
+    std::string name;
+    std::uint64_t iterations;
+    double seconds;
+    double NsPerOp() const { return seconds * 1e9 / static_cast<double>(iterations); }
+};
+
+class Harness {
+ public:
+    explicit Harness(const BenchOptions& options) : options_(options) {}
+
+    bool Enabled(const std::string& name) const {
+        return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+    }
+
+    // run(n) executa n operações; repete dobrando n até passar do tempo mínimo
+    template <typename Fn>
+    void Run(const std::string& name, Fn&& run) {
+        RunTimed(name, [&](std::uint64_t n) {
+            Clock::time_point start = Clock::now();
+            run(n);
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        });
+    }
+
+    // Como Run, mas run(n) devolve os segundos gastos só na parte medida
+    template <typename Fn>
+    void RunTimed(const std::string& name, Fn&& run) {
+        if (!Enabled(name)) return;
+        std::uint64_t n = 1;
+        while (true) {
+            double seconds = run(n);
+            if (seconds >= options_.min_time || n >= (std::uint64_t{1} << 40)) {
+                Record(name, n, seconds);
+                return;
+            }
+            // Estima quantas cabem no tempo mínimo, sem crescer mais que 10x
+            double target = seconds > 0 ? options_.min_time / seconds * 1.2 : 10.0;
+            n = std::max(n * 2, static_cast<std::uint64_t>(n * std::min(target, 10.0)));
+        }
+    }
+
+    // Para operações que só fazem sentido uma vez (salvar, carregar)
+    void Record(const std::string& name, std::uint64_t iterations, double seconds) {
+        results_.push_back({name, iterations, seconds});
+        const Result& r = results_.back();
+        std::cout << std::left << std::setw(32) << r.name << std::right << std::setw(14) << std::fixed
+                  << std::setprecision(1) << r.NsPerOp() << " ns/op" << std::setw(14) << r.iterations
+                  << " iters\n";
+    }
+
+    bool WriteJson(const std::string& path) const {
+        std::ofstream out(path);
+        std::time_t now = std::time(nullptr);
+        char date[32];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+        out << "{\n  \"context\": {\"date\": \"" << date << "\", \"label\": \"" << Escape(options_.label)
+            << "\", \"num_cpus\": " << std::thread::hardware_concurrency()
+            << ", \"min_time\": " << options_.min_time << ", \"quick\": " << (options_.quick ? "true" : "false")
+            << "},\n  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results_.size(); ++i) {
+            const Result& r = results_[i];
+            out << (i ? ",\n" : "\n") << "    {\"name\": \"" << Escape(r.name) << "\", \"iterations\": "
+                << r.iterations << ", \"real_time_s\": " << std::setprecision(9) << r.seconds
+                << ", \"ns_per_op\": " << std::setprecision(3) << r.NsPerOp() << "}";
+        }
+        out << "\n  ]\n}\n";
+        return static_cast<bool>(out);
+    }
+
+ private:
+    static std::string Escape(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') out.push_back('\\');
+            out.push_back(c);
+        }
+        return out;
+    }
+
+    const BenchOptions& options_;
+    std::vector<Result> results_;
+};
+
+// Conduz a cobra em zigue-zague pelas linhas: anda width - 1 células,
+// desce uma, volta. Nunca bate em si mesma enquanto a grade tiver mais
+// células que a cobra, então o comprimento fica constante.
+class Serpentine {
+ public:
+    explicit Serpentine(int width) : width_(width) {}
+
+    Snake::Direction Next() {
+        if (run_ == width_ - 1) {
+            run_ = 0;
+            right_ = !right_;
+            return Snake::Direction::kDown;
+        }
+        ++run_;
+        return right_ ? Snake::Direction::kRight : Snake::Direction::kLeft;
+    }
+
+ private:
+    int width_;
+    int run_{0};
+    bool right_{true};
+};
+
+// Cobra de comprimento `length` numa grade com folga, já em movimento
+struct SnakeFixture {
+    explicit SnakeFixture(int length)
+        : side(static_cast<int>(std::ceil(std::sqrt(2.0 * length))) + 2),
+          grid(side, side),
+          snake(side, side, 1.0f),
+          path(side) {
+        snake.AttachGrid(&grid);
+        while (snake.size < length) {
+            snake.GrowBody();
+            Step();
+        }
+    }
+
+    void Step() {
+        snake.direction = path.Next();
+        snake.Update();
+    }
+
+    int side;
+    OccupancyGrid grid;
+    Snake snake;
+    Serpentine path;
+};
+
+std::string Name(const std::string& base, const std::string& key, std::uint64_t value) {
+    return base + "/" + key + "=" + std::to_string(value);
+}
+
+void BenchSnake(Harness& harness, const BenchOptions& options) {
+    std::vector<int> lengths = {10, 100, 1000, 10000, 100000, 1000000};
+    if (options.quick) lengths.resize(4);
+    for (int length : lengths) {
+        std::string update_name = Name("snake_update", "len", length);
+        std::string cell_name = Name("snake_cell", "len", length);
+        if (!harness.Enabled(update_name) && !harness.Enabled(cell_name)) continue;
+        SnakeFixture fixture(length);
+        harness.Run(update_name, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) fixture.Step();
+        });
+        if (!fixture.snake.alive || fixture.snake.size != length) {
+            throw std::runtime_error(update_name + ": snake died or changed size");
+        }
+
+        // Células sorteadas antes, para medir só a consulta
+        Rng rng(1);
+        std::vector<SDL_Point> queries(4096);
+        for (SDL_Point& q : queries) {
+            q.x = static_cast<int>(rng.UniformInt(static_cast<std::uint32_t>(fixture.side)));
+            q.y = static_cast<int>(rng.UniformInt(static_cast<std::uint32_t>(fixture.side)));
+        }
+        volatile int sink = 0;
+        harness.Run(cell_name, [&](std::uint64_t n) {
+            int hits = 0;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                const SDL_Point& q = queries[i & (queries.size() - 1)];
+                hits += fixture.snake.SnakeCell(q.x, q.y);
+            }
+            sink = sink + hits;
+        });
+    }
+}
+
+void BenchPlaceFood(Harness& harness) {
+    const int side = 256;
+    const int cells = side * side;
+    for (int percent : {0, 25, 50, 75, 90, 99}) {
+        std::string name = Name("place_food", "fill", percent);
+        if (!harness.Enabled(name)) continue;
+        // Obstáculos ocupam a fração pedida (a cobra e a comida somam 2 células)
+        int obstacles = std::max(0, cells * percent / 100 - 2);
+        Simulation sim(side, side, 0.1f, obstacles, 7);
+        harness.Run(name, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) sim.PlaceFood();
+        });
+    }
+}
+
+void BenchFindCell(Harness& harness, const BenchOptions& options) {
+    std::vector<std::size_t> sizes = {16, 256, 4096, 65536, 1 << 20};
+    if (options.quick) sizes.resize(4);
+    for (std::size_t size : sizes) {
+        // Células distintas e a procurada fora delas: pior caso, varre tudo
+        std::vector<std::uint32_t> cells(size);
+        for (std::size_t i = 0; i < size; ++i) cells[i] = static_cast<std::uint32_t>(2 * i);
+        const std::uint32_t missing = 1;
+        for (CellKernel kernel : {CellKernel::kScalar, CellKernel::kSse2, CellKernel::kAvx2}) {
+            if (!CellKernelSupported(kernel)) continue;
+            std::string name = Name(std::string("find_cell/") + CellKernelName(kernel), "n", size);
+            if (!harness.Enabled(name)) continue;
+            if (FindCellWith(kernel, cells.data(), size, missing) != size ||
+                FindCellWith(kernel, cells.data(), size, cells[size - 1]) != size - 1) {
+                throw std::runtime_error(name + ": wrong result");
+            }
+            volatile std::size_t sink = 0;
+            harness.Run(name, [&](std::uint64_t n) {
+                std::size_t found = 0;
+                for (std::uint64_t i = 0; i < n; ++i) found += FindCellWith(kernel, cells.data(), size, missing);
+                sink = sink + found;
+            });
+        }
+    }
+}
+
+// Uma rodada como a do Game, toda na RoundArena
+struct Round {
+    static constexpr int kObstacles = 64;
+
+    Round(RoundArena& arena, int side) : arena_(arena), side_(side) { Restart(); }
+
+    void Restart() {
+        snapshots.reset();
+        bot.reset();
+        sim.reset();
+        arena_.Reset();
+        sim.emplace(side_, side_, 0.16f, kObstacles, seed++, arena_.Resource());
+        bot.emplace(Bot::kDefaultExpansionBudget, arena_.Resource());
+        snapshots.emplace(side_, side_, arena_.Resource());
+        sim->TrackChangedCells(true);
+        snapshots->Publish(*sim, false, Clock::now());
+    }
+
+    void Tick() {
+        if (sim->IsOver()) Restart();
+        sim->Step(bot->NextInput(*sim));
+        snapshots->Publish(*sim, false, Clock::now());
+        snapshots->Acquire();
+    }
+
+    std::optional<Simulation> sim;
+    std::optional<Bot> bot;
+    std::optional<SnapshotBuffer> snapshots;
+    std::uint32_t seed{1};
+
+ private:
+    RoundArena& arena_;
+    int side_;
+};
+
+// Roda run(n) contando as alocações só dentro dela (o harness aloca ao
+// registrar o resultado) e falha se houver alguma
+template <typename Fn>
+void RunWithoutAllocations(Harness& harness, const std::string& name, Fn&& run) {
+    std::uint64_t count = 0;
+    harness.Run(name, [&](std::uint64_t n) {
+        std::uint64_t before = HeapAllocations();
+        run(n);
+        count += HeapAllocations() - before;
+    });
+    if (count != 0) throw std::runtime_error(name + ": " + std::to_string(count) + " heap allocations");
+}
+
+void BenchRounds(Harness& harness, const BenchOptions& options) {
+    std::vector<int> sides = {32, 256, 1024};
+    if (options.quick) sides.resize(2);
+    for (int side : sides) {
+        std::string reset_name = Name("round_reset", "grid", side);
+        std::string tick_name = Name("steady_tick", "grid", side);
+        std::string sim_reset_name = Name("sim_reset", "grid", side);
+        if (!harness.Enabled(reset_name) && !harness.Enabled(tick_name) &&
+            !harness.Enabled(sim_reset_name + "/regenerate") && !harness.Enabled(sim_reset_name + "/keep")) {
+            continue;
+        }
+        RoundArena arena;
+        Round round(arena, side);
+        // Aquecimento: a arena cresce até caber uma rodada inteira e o bot
+        // dimensiona seus buffers
+        for (int i = 0; i < 2; ++i) {
+            round.Tick();
+            round.Restart();
+        }
+
+        RunWithoutAllocations(harness, reset_name, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) round.Restart();
+        });
+        RunWithoutAllocations(harness, tick_name, [&](std::uint64_t n) {
+            for (std::uint64_t i = 0; i < n; ++i) round.Tick();
+        });
+
+        // Reset no lugar: o custo é o da grade (volta à ordem inicial das
+        // livres) mais recolocar comida e obstáculos
+        for (ObstacleLayout layout : {ObstacleLayout::Regenerate, ObstacleLayout::Keep}) {
+            std::string name = sim_reset_name + (layout == ObstacleLayout::Keep ? "/keep" : "/regenerate");
+            RunWithoutAllocations(harness, name, [&](std::uint64_t n) {
+                for (std::uint64_t i = 0; i < n; ++i) round.sim->Reset(round.seed++, layout);
+            });
+        }
+    }
+}
+
+void RemoveScoreFiles(const std::string& base) {
+    for (const char* ext : {".log", ".idx", ".idx.tmp", ".txt"}) std::remove((base + ext).c_str());
+}
+
+void BenchScores(Harness& harness, const BenchOptions& options) {
+    const std::string base = "snake_bench_scores";
+    std::vector<int> sizes = {10, 1000, 100000, 1000000};
+    if (options.quick) sizes.resize(2);
+    std::vector<std::string> names;
+    for (int i = 0; i < 100; ++i) names.push_back("bench" + std::to_string(i));
+    for (int size : sizes) {
+        std::string add_name = Name("scores_add", "n", size);
+        std::string save_name = Name("scores_save", "n", size);
+        std::string load_name = Name("scores_load", "n", size);
+        if (!harness.Enabled(add_name) && !harness.Enabled(save_name) && !harness.Enabled(load_name)) continue;
+        RemoveScoreFiles(base);
+        {
+            ScoreManager scores(base);
+            Rng rng(static_cast<std::uint32_t>(size));
+            Clock::time_point start = Clock::now();
+            for (int i = 0; i < size; ++i) {
+                scores.AddScore(names[i % names.size()], static_cast<int>(rng.UniformInt(100000)));
+            }
+            harness.Record(add_name, size, std::chrono::duration<double>(Clock::now() - start).count());
+
+            start = Clock::now();
+            scores.SaveScoresAsync().get();
+            harness.Record(save_name, 1, std::chrono::duration<double>(Clock::now() - start).count());
+        }
+        Clock::time_point start = Clock::now();
+        {
+            ScoreManager scores(base);
+            if (scores.TotalScores() != static_cast<std::uint64_t>(size) || scores.GetHighScores(20).empty()) {
+                throw std::runtime_error(load_name + ": scores were not reloaded");
+            }
+            harness.Record(load_name, 1, std::chrono::duration<double>(Clock::now() - start).count());
+        }
+        RemoveScoreFiles(base);
+    }
+}
+
+// Roda a simulação e desenha cada tick como a RenderThread: snapshot,
+// cópia da grade, Render. full repinta tudo em todo quadro (o custo antigo).
+// Só o Render entra no tempo.
+void BenchRender(Harness& harness, const std::string& name, int grid_side, bool full) {
+    if (!harness.Enabled(name)) return;
+    Renderer renderer(640, 640, grid_side, grid_side, 0, true);
+    renderer.CreateContext();
+    OccupancyGrid grid(grid_side, grid_side);
+    grid.TrackChanges(true);
+    Serpentine path(grid_side);
+    std::unique_ptr<Simulation> sim;
+    std::unique_ptr<SnapshotBuffer> snapshots;
+    std::uint32_t seed = 3;
+
+    harness.RunTimed(name, [&](std::uint64_t n) {
+        double seconds = 0;
+        for (std::uint64_t i = 0; i < n; ++i) {
+            if (!sim || sim->IsOver()) {
+                // Nova rodada: o próximo snapshot traz a grade inteira
+                sim = std::make_unique<Simulation>(grid_side, grid_side, 0.5f, grid_side * grid_side / 40, seed++);
+                sim->TrackChangedCells(true);
+                snapshots = std::make_unique<SnapshotBuffer>(grid_side, grid_side);
+            }
+            SimInput input;
+            input.turn = true;
+            input.direction = path.Next();
+            sim->Step(input);
+            snapshots->Publish(*sim, false, Clock::now());
+            const FrameSnapshot* frame = snapshots->Acquire();
+            if (ApplySnapshot(*frame, grid) || full) renderer.ResetBoard();
+            Clock::time_point start = Clock::now();
+            renderer.Render(*frame, grid, 0.5f);
+            seconds += std::chrono::duration<double>(Clock::now() - start).count();
+            grid.ClearChanges();
+        }
+        return seconds;
+    });
+    renderer.DestroyContext();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    try {
+        if (!ParseArgs(argc, argv, options)) {
+            PrintUsage();
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        PrintUsage();
+        return 1;
+    }
+
+    Harness harness(options);
+    try {
+        BenchSnake(harness, options);
+        BenchPlaceFood(harness);
+        BenchFindCell(harness, options);
+        BenchRounds(harness, options);
+        BenchScores(harness, options);
+        BenchRender(harness, "render/grid=32/incremental", 32, false);
+        BenchRender(harness, "render/grid=32/full", 32, true);
+        BenchRender(harness, "render/grid=4096/camera", 4096, false);
+    } catch (const std::exception& e) {
+        std::cerr << "snake_bench: " << e.what() << "\n";
+        return 1;
+    }
+
+    if (!options.json_path.empty()) {
+        if (!harness.WriteJson(options.json_path)) {
+            std::cerr << "could not write " << options.json_path << "\n";
+            return 1;
+        }
+        std::cout << "results written to " << options.json_path << "\n";
+    }
+    return 0;
+}
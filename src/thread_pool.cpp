@@ -0,0 +1,89 @@
+#include "thread_pool.h"
+
+namespace {
+thread_local int current_worker = -1;
+}
+
+ThreadPool::ThreadPool(unsigned num_threads) {
+  if (num_threads == 0) num_threads = 1;
+  for (unsigned i = 0; i < num_threads; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (unsigned i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  Wait();
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stop_ = true;
+  }
+  wake_cv_.notify_all();
+  for (auto& thread : threads_) thread.join();
+}
+
+int ThreadPool::CurrentWorker() { return current_worker; }
+
+void ThreadPool::Submit(std::function<void()> task) {
+  // Dentro de um worker, empilha na própria fila; fora, distribui em rodízio.
+  unsigned index = current_worker >= 0
+                       ? static_cast<unsigned>(current_worker)
+                       : next_queue_.fetch_add(1, std::memory_order_relaxed) % Size();
+  pending_.fetch_add(1);
+  queued_.fetch_add(1);
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  // Passa pelo mutex para não perder o aviso de um worker prestes a dormir.
+  { std::lock_guard<std::mutex> lock(wake_mutex_); }
+  wake_cv_.notify_one();
+}
+
+void ThreadPool::Wait() {
+  std::unique_lock<std::mutex> lock(wake_mutex_);
+  done_cv_.wait(lock, [this]() { return pending_.load() == 0; });
+}
+
+bool ThreadPool::PopLocal(unsigned index, std::function<void()>& task) {
+  Queue& queue = *queues_[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty()) return false;
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  return true;
+}
+
+bool ThreadPool::Steal(unsigned thief, std::function<void()>& task) {
+  for (unsigned offset = 1; offset < Size(); ++offset) {
+    Queue& queue = *queues_[(thief + offset) % Size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) continue;
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::WorkerLoop(unsigned index) {
+  current_worker = static_cast<int>(index);
+  std::function<void()> task;
+  while (true) {
+    if (PopLocal(index, task) || Steal(index, task)) {
+      queued_.fetch_sub(1);
+      task();
+      task = nullptr;
+      if (pending_.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        done_cv_.notify_all();
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_cv_.wait(lock, [this]() { return stop_ || queued_ > 0; });
+    if (stop_ && queued_ == 0) return;
+  }
+}
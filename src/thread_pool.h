@@ -0,0 +1,57 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads com roubo de trabalho: cada worker tem sua própria fila,
+// consome do fim dela (LIFO) e, quando vazia, rouba do início da fila de
+// outro worker. Tarefas enviadas por um worker vão para a fila dele.
+class ThreadPool {
+ public:
+  explicit ThreadPool(unsigned num_threads = std::thread::hardware_concurrency());
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void Submit(std::function<void()> task);
+
+  // Bloqueia até todas as tarefas enviadas terminarem.
+  void Wait();
+
+  unsigned Size() const { return static_cast<unsigned>(threads_.size()); }
+
+  // Índice do worker que está executando a chamada, ou -1 fora do pool.
+  static int CurrentWorker();
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void WorkerLoop(unsigned index);
+  bool PopLocal(unsigned index, std::function<void()>& task);
+  bool Steal(unsigned thief, std::function<void()>& task);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> threads_;
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  std::condition_variable done_cv_;
+  std::atomic<std::size_t> queued_{0};   // tarefas ainda nas filas
+  std::atomic<std::size_t> pending_{0};  // enviadas e ainda não concluídas
+  std::atomic<unsigned> next_queue_{0};
+  bool stop_{false};
+};
+
+#endif  // THREAD_POOL_H
@@ -0,0 +1,44 @@
+#include "timer_wheel.h"
+#include <algorithm>
+
+TimerWheel::TimerWheel(std::size_t num_slots, std::pmr::memory_resource *resource)
+    : slots_(resource), due_(resource) {
+  std::size_t size = 1;
+  while (size < num_slots) size <<= 1;
+  slots_.resize(size);  // os slots herdam o recurso do vector externo
+  for (auto &slot : slots_) slot.reserve(kSlotReserve);
+  due_.reserve(kSlotReserve);
+  mask_ = size - 1;
+}
+
+void TimerWheel::Reset() {
+  if (pending_ > 0) {
+    for (auto &slot : slots_) slot.clear();
+  }
+  due_.clear();
+  now_ = 0;
+  next_id_ = 1;
+  pending_ = 0;
+}
+
+TimerWheel::Handle TimerWheel::Schedule(std::uint64_t delay_ticks, TimedEvent event) {
+  Handle handle;
+  handle.id = next_id_++;
+  handle.deadline = now_ + std::max<std::uint64_t>(delay_ticks, 1);
+  slots_[handle.deadline & mask_].push_back({handle.id, handle.deadline, event});
+  ++pending_;
+  return handle;
+}
+
+bool TimerWheel::Cancel(Handle &handle) {
+  if (!handle) return false;
+  std::uint64_t id = handle.id;
+  std::pmr::vector<Entry> &slot = slots_[handle.deadline & mask_];
+  handle = Handle{};
+  // Preserva a ordem dos restantes (ordem de disparo)
+  auto it = std::find_if(slot.begin(), slot.end(), [id](const Entry &e) { return e.id == id; });
+  if (it == slot.end()) return false;
+  slot.erase(it);
+  --pending_;
+  return true;
+}
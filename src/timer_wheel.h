@@ -0,0 +1,85 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+// Eventos com prazo da simulação. Novos power-ups entram aqui.
+enum class TimedEvent { BonusFoodExpire, SpeedEffectExpire };
+
+// Roda de timers com hash, avançada pelo próprio loop de ticks: sem
+// threads nem locks. Cada slot guarda os timers cujo prazo cai nele
+// (prazo % número de slots); prazos mais longos que uma volta ficam no
+// slot e são ignorados até a volta certa. Timers do mesmo tick disparam
+// na ordem em que foram agendados, o que mantém a simulação determinística.
+class TimerWheel {
+ public:
+  struct Handle {
+    std::uint64_t id{0};  // 0 = nenhum timer
+    std::uint64_t deadline{0};
+    explicit operator bool() const { return id != 0; }
+  };
+
+  // num_slots é arredondado para potência de dois. Cada slot já nasce com
+  // espaço para kSlotReserve timers, tirado de resource: agendar não aloca
+  // enquanto nenhum slot passar disso.
+  static constexpr std::size_t kSlotReserve = 2;
+  explicit TimerWheel(std::size_t num_slots = 256,
+                      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+  // Agenda event para daqui a delay_ticks (mínimo 1) ticks.
+  Handle Schedule(std::uint64_t delay_ticks, TimedEvent event);
+
+  // Cancela um timer pendente; devolve false se ele já disparou.
+  // Zera o handle.
+  bool Cancel(Handle &handle);
+
+  // Descarta todos os timers e volta ao tick 0, mantendo a memória dos slots.
+  void Reset();
+
+  // Avança um tick e chama fire(event) para cada timer vencido.
+  template <typename Fn>
+  void Advance(Fn &&fire);
+
+  std::uint64_t Now() const { return now_; }
+  std::size_t Pending() const { return pending_; }
+
+ private:
+  struct Entry {
+    std::uint64_t id;
+    std::uint64_t deadline;
+    TimedEvent event;
+  };
+
+  std::pmr::vector<std::pmr::vector<Entry>> slots_;
+  std::pmr::vector<Entry> due_;  // reaproveitado entre ticks
+  std::size_t mask_;
+  std::uint64_t now_{0};
+  std::uint64_t next_id_{1};
+  std::size_t pending_{0};
+};
+
+template <typename Fn>
+void TimerWheel::Advance(Fn &&fire) {
+  ++now_;
+  std::pmr::vector<Entry> &slot = slots_[now_ & mask_];
+  if (slot.empty()) return;
+
+  // Separa os vencidos antes de disparar: fire pode agendar novos timers
+  due_.clear();
+  std::size_t kept = 0;
+  for (const Entry &entry : slot) {
+    if (entry.deadline == now_) {
+      due_.push_back(entry);
+    } else {
+      slot[kept++] = entry;
+    }
+  }
+  slot.resize(kept);
+  pending_ -= due_.size();
+  for (const Entry &entry : due_) fire(entry.event);
+}
+
+#endif  // TIMER_WHEEL_H